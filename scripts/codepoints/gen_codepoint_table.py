@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+#
+# Generates a binary codepoint table (see CZ::AKCodepointTable) from a .codepoints file.
+#
+# Usage: gen_codepoint_table.py <input.codepoints> <output.bin>
+#
+# Layout (little-endian):
+#
+#   Header      magic, version, count, bucketCount, stringsSize (UInt32 each)
+#   Buckets     bucketCount x UInt32 displacement seeds
+#   Entries     count x { UInt32 nameOffset, UInt16 nameLength, UInt8 utf8Length, UInt8 pad, UInt8 utf8[4], UInt32 codepoint }
+#   Strings     icon names, not null-terminated
+#
+# Lookup: bucket = Hash(name, 0) % bucketCount, entry = Hash(name, buckets[bucket]) % count.
+# The displacements are chosen so that every name maps to a distinct entry (minimal perfect hash).
+# Hash() must match AKCodepointTable::Hash().
+
+import struct
+import sys
+
+MAGIC = 0x50434B41  # "AKCP"
+VERSION = 1
+MASK = (1 << 64) - 1
+
+
+def hash_name(name, seed):
+    h = (0xCBF29CE484222325 ^ ((seed * 0x9E3779B97F4A7C15) & MASK)) & MASK
+    for b in name:
+        h ^= b
+        h = (h * 0x100000001B3) & MASK
+    h ^= h >> 33
+    h = (h * 0xFF51AFD7ED558CCD) & MASK
+    h ^= h >> 33
+    return h
+
+
+def utf8(codepoint):
+    return chr(codepoint).encode('utf-8')
+
+
+def parse(path):
+    # Later duplicates override earlier ones, same as AKIconFont::ParseCodepoints()
+    codepoints = {}
+    with open(path, 'r', encoding='utf-8') as file:
+        for number, line in enumerate(file, 1):
+            fields = line.split()
+            if not fields:
+                continue
+            if len(fields) < 2:
+                sys.exit(f'{path}:{number}: missing name or hex code')
+            codepoints[fields[0].encode('utf-8')] = int(fields[1], 16)
+    return codepoints
+
+
+def build(codepoints):
+    names = list(codepoints.keys())
+    count = len(names)
+    bucket_count = max(1, (count + 3) // 4)
+    buckets = [[] for _ in range(bucket_count)]
+
+    for i, name in enumerate(names):
+        buckets[hash_name(name, 0) % bucket_count].append(i)
+
+    slots = [-1] * count
+    displacements = [0] * bucket_count
+
+    # Largest buckets first, they are the hardest to place
+    for bucket in sorted(range(bucket_count), key=lambda b: -len(buckets[b])):
+        keys = buckets[bucket]
+        if not keys:
+            continue
+
+        seed = 1
+        while True:
+            positions = [hash_name(names[i], seed) % count for i in keys]
+            if len(set(positions)) == len(positions) and all(slots[p] == -1 for p in positions):
+                break
+            seed += 1
+            if seed > 0xFFFFFFFF:
+                sys.exit('failed to build the perfect hash')
+
+        displacements[bucket] = seed
+        for i, position in zip(keys, positions):
+            slots[position] = i
+
+    return names, slots, displacements
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(f'usage: {sys.argv[0]} <input.codepoints> <output.bin>')
+
+    codepoints = parse(sys.argv[1])
+    names, slots, displacements = build(codepoints)
+
+    strings = bytearray()
+    entries = bytearray()
+
+    for slot in slots:
+        name = names[slot]
+        codepoint = codepoints[name]
+        encoded = utf8(codepoint)
+        entries += struct.pack('<IHBB4sI', len(strings), len(name), len(encoded), 0, encoded.ljust(4, b'\0'), codepoint)
+        strings += name
+
+    with open(sys.argv[2], 'wb') as out:
+        out.write(struct.pack('<5I', MAGIC, VERSION, len(names), len(displacements), len(strings)))
+        out.write(struct.pack(f'<{len(displacements)}I', *displacements))
+        out.write(entries)
+        out.write(strings)
+
+
+if __name__ == '__main__':
+    main()
@@ -19,6 +19,10 @@ void CZ::setTheme(AKTheme *theme) noexcept
         m_theme = theme;
     else
         m_theme = new AKTheme();
+
+    // Assets requested from the previous theme are never delivered
+    if (auto app { AKApp::Get() })
+        app->notifyAssetsReady();
 }
 
 class AKKeyboard &CZ::akKeyboard() noexcept
@@ -15,11 +15,15 @@ namespace CZ
 {
     class AKApp;
     class AKObject;
+    class AKAnimation; /* Animation ticked once per frame by AKApp */
 
     class AKTheme;
     class AKColorTheme;
     class AKChanges;
     class AKBackgroundDamageTracker;
+    class AKTextBuffer; /* UTF-8 gap buffer used by AKText */
+    class AKAssetCache; /* Budgeted cache of AKTheme generated assets */
+    class AKCodepointTable; /* Memory-mapped icon name to codepoint table */
 
     class AKScene;  /* Renders a root AKNode into an AKTarget */
     class AKTarget;
@@ -52,6 +56,7 @@ namespace CZ
     class AKWindowButtonGroup;
     class AKScroll;
     class AKScrollBar;
+    class AKListView;
 
     class AKIconFont;
 
@@ -0,0 +1,78 @@
+#include <CZ/AK/AKAnimation.h>
+#include <CZ/AK/AKApp.h>
+#include <CZ/AK/Nodes/AKNode.h>
+#include <algorithm>
+
+using namespace CZ;
+
+AKAnimation::AKAnimation(AKNode &node, UInt32 durationMs) noexcept :
+    m_app(AKApp::Get()),
+    m_node(&node),
+    m_duration(durationMs)
+{
+    // The finish callback isn't called, it would likely access the node being destroyed
+    m_node.setOnDestroyCallback([this](CZObject *) {
+        if (!m_running)
+            return;
+
+        m_running = false;
+        std::erase(m_app->m_animations, this);
+    });
+}
+
+AKAnimation::~AKAnimation()
+{
+    notifyDestruction();
+
+    if (m_running)
+        std::erase(m_app->m_animations, this);
+}
+
+void AKAnimation::start() noexcept
+{
+    if (!m_node)
+        return;
+
+    m_startTime = std::chrono::steady_clock::now();
+    m_value = 0.f;
+
+    if (!m_running)
+    {
+        m_running = true;
+        m_app->m_animations.emplace_back(this);
+    }
+
+    m_node->repaint();
+}
+
+void AKAnimation::stop() noexcept
+{
+    if (m_running)
+        finish();
+}
+
+void AKAnimation::tick(std::chrono::steady_clock::time_point time) noexcept
+{
+    const auto elapsed { std::chrono::duration_cast<std::chrono::milliseconds>(time - m_startTime).count() };
+
+    if (m_duration == 0 || elapsed >= m_duration)
+        m_value = 1.f;
+    else
+        m_value = std::max(SkScalar(elapsed) / SkScalar(m_duration), 0.f);
+
+    if (m_onUpdate)
+        m_onUpdate(this);
+
+    // The update callback may have stopped or restarted it
+    if (m_running && m_value >= 1.f)
+        finish();
+}
+
+void AKAnimation::finish() noexcept
+{
+    m_running = false;
+    std::erase(m_app->m_animations, this);
+
+    if (m_onFinish)
+        m_onFinish(this);
+}
@@ -0,0 +1,87 @@
+#ifndef CZ_AKANIMATION_H
+#define CZ_AKANIMATION_H
+
+#include <CZ/AK/AKObject.h>
+#include <CZ/Core/CZWeak.h>
+#include <CZ/skia/core/SkScalar.h>
+#include <functional>
+#include <memory>
+#include <chrono>
+
+/**
+ * @brief Animation synchronized with the scene frames.
+ *
+ * Running animations are not driven by timers. AKApp ticks all of them together right before an AKScene
+ * lays out and renders a frame, using the same timestamp (AKApp::frameTime()), so that any number of
+ * concurrent animations cause a single layout and render pass. While running, the node passed to the
+ * constructor is repainted after each frame to request the next one, and nothing wakes up once all animations finish.
+ *
+ * Frames are only requested through the node, so animations of nodes not presented on any target progress
+ * only when something else is rendered. If the node is destroyed, the animation stops without calling
+ * the finish callback and can't be started again.
+ */
+class CZ::AKAnimation : public AKObject
+{
+public:
+    AKAnimation(AKNode &node, UInt32 durationMs = 0) noexcept;
+    ~AKAnimation();
+
+    /**
+     * @brief Duration in milliseconds.
+     *
+     * Changes take effect on the next start() call.
+     */
+    void setDuration(UInt32 ms) noexcept { m_duration = ms; }
+    UInt32 duration() const noexcept { return m_duration; }
+
+    /**
+     * @brief Starts the animation, or restarts it if already running.
+     *
+     * The update callback is first called during the next frame. Does nothing if the node was destroyed.
+     */
+    void start() noexcept;
+
+    /**
+     * @brief Stops the animation.
+     *
+     * If it was running, the finish callback is called immediately.
+     */
+    void stop() noexcept;
+    bool running() const noexcept { return m_running; }
+
+    /**
+     * @brief Linear progress in the [0, 1] range as of the last frame.
+     */
+    SkScalar value() const noexcept { return m_value; }
+
+    /**
+     * @brief The node repainted to request frames, nullptr if destroyed.
+     */
+    AKNode *node() const noexcept { return m_node; }
+
+    /**
+     * @brief Called once per frame while running, including the last one where value() is 1.
+     */
+    void setOnUpdateCallback(std::function<void(AKAnimation*)> callback) noexcept { m_onUpdate = std::move(callback); }
+
+    /**
+     * @brief Called after the last update or when stopped.
+     */
+    void setOnFinishCallback(std::function<void(AKAnimation*)> callback) noexcept { m_onFinish = std::move(callback); }
+private:
+    friend class AKApp;
+    void tick(std::chrono::steady_clock::time_point time) noexcept;
+    void finish() noexcept;
+
+    // To keep the app alive
+    std::shared_ptr<AKApp> m_app;
+    CZWeak<AKNode> m_node;
+    std::function<void(AKAnimation*)> m_onUpdate;
+    std::function<void(AKAnimation*)> m_onFinish;
+    std::chrono::steady_clock::time_point m_startTime {};
+    UInt32 m_duration { 0 };
+    SkScalar m_value { 0.f };
+    bool m_running { false };
+};
+
+#endif // CZ_AKANIMATION_H
@@ -1,7 +1,9 @@
 #include <CZ/Core/Events/CZEvent.h>
 #include <CZ/AK/AKApp.h>
+#include <CZ/AK/AKAnimation.h>
 #include <CZ/AK/AKScene.h>
 #include <CZ/AK/AKLog.h>
+#include <CZ/AK/Nodes/AKNode.h>
 
 #include <CZ/Ream/RCore.h>
 #include <CZ/Core/CZCore.h>
@@ -9,17 +11,35 @@
 
 #include <CZ/skia/ports/SkFontMgr_fontconfig.h>
 
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
 using namespace CZ;
 
 static std::weak_ptr<AKApp> s_app;
 
+static std::chrono::microseconds ElapsedSince(std::chrono::steady_clock::time_point start) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+static std::pair<sk_sp<SkFontMgr>, std::chrono::microseconds> MakeFontManager() noexcept
+{
+    const auto start { std::chrono::steady_clock::now() };
+    auto fontManager { SkFontMgr_New_FontConfig(nullptr) };
+    return { fontManager, ElapsedSince(start) };
+}
+
 AKApp::AKApp(std::shared_ptr<CZCore> cuarzo, std::shared_ptr<RCore> ream) noexcept : m_cuarzo(cuarzo), m_ream(ream)
 {
-    m_fontManager = SkFontMgr_New_FontConfig(nullptr);
-    assert("Failed to create the font manager" && m_fontManager);
-    m_fontCollection = sk_make_sp<skia::textlayout::FontCollection>();
-    m_fontCollection->setDefaultFontManager(m_fontManager);
-    m_fontCollection->enableFontFallback();
+    m_asyncTimer.setCallback([this](CZTimer *) {
+        pollAsyncTasks();
+    });
+
+    m_frameTimer.setCallback([this](CZTimer *) {
+        emitFrameRequests();
+    });
 }
 
 std::shared_ptr<AKApp> AKApp::GetOrMake() noexcept
@@ -45,7 +65,11 @@ std::shared_ptr<AKApp> AKApp::GetOrMake() noexcept
 
     auto app { std::shared_ptr<AKApp>(new AKApp(cuarzo, ream)) };
     s_app = app;
+    app->addStartupStep("AKApp", ElapsedSince(app->m_startTime));
+
+    const auto themeStart { std::chrono::steady_clock::now() };
     setTheme(nullptr);
+    app->addStartupStep("AKTheme", ElapsedSince(themeStart));
     return app;
 }
 
@@ -56,14 +80,67 @@ std::shared_ptr<CZ::AKApp> AKApp::Get() noexcept
 
 sk_sp<SkFontMgr> AKApp::fontManager() const noexcept
 {
+    if (m_fontManager)
+        return m_fontManager;
+
+    const bool background { m_fontManagerFuture.valid() };
+    const auto [fontManager, duration] { background ? m_fontManagerFuture.get() : MakeFontManager() };
+    m_fontManager = fontManager;
+    assert("Failed to create the font manager" && m_fontManager);
+    addStartupStep("SkFontMgr (fontconfig)", duration, background);
     return m_fontManager;
 }
 
 sk_sp<skia::textlayout::FontCollection> AKApp::fontCollection() const noexcept
 {
+    if (m_fontCollection)
+        return m_fontCollection;
+
+    auto fontManager { this->fontManager() };
+    const auto start { std::chrono::steady_clock::now() };
+    m_fontCollection = sk_make_sp<skia::textlayout::FontCollection>();
+    m_fontCollection->setDefaultFontManager(fontManager);
+    m_fontCollection->enableFontFallback();
+    addStartupStep("FontCollection", ElapsedSince(start));
     return m_fontCollection;
 }
 
+void AKApp::preloadFonts() noexcept
+{
+    if (m_fontManager || m_fontManagerFuture.valid())
+        return;
+
+    m_fontManagerFuture = std::async(std::launch::async, MakeFontManager);
+}
+
+void AKApp::addStartupStep(const std::string &name, std::chrono::microseconds duration, bool background) const noexcept
+{
+    m_startupProfile.emplace_back(name, duration, background);
+}
+
+std::string AKApp::startupReport() const noexcept
+{
+    std::ostringstream report;
+    report << "Startup profile:\n";
+
+    for (const auto &step : m_startupProfile)
+        report << "  " << std::left << std::setw(28) << step.name
+               << std::right << std::setw(10) << std::fixed << std::setprecision(2) << step.duration.count() / 1000.0 << " ms"
+               << (step.background ? " (background)" : "") << "\n";
+
+    return report.str();
+}
+
+void AKApp::onFirstFrame() noexcept
+{
+    if (m_firstFrameDone)
+        return;
+
+    m_firstFrameDone = true;
+    addStartupStep("First frame (since start)", ElapsedSince(m_startTime));
+    AKLog(CZDebug, "{}", startupReport());
+}
+
 AKKeyboard &AKApp::keyboard() noexcept
 {
     if (!m_keyboard)
@@ -134,3 +211,153 @@ void AKApp::setKeyboard(AKKeyboard *keyboard) noexcept
     m_keyboard.reset(keyboard);
 }
 
+void AKApp::runAsync(std::function<void()> task, std::function<void()> onDone) noexcept
+{
+    if (!task)
+        return;
+
+    m_asyncTasks.emplace_back(std::async(std::launch::async, std::move(task)), std::move(onDone));
+
+    if (m_asyncTasks.size() == 1)
+        m_asyncTimer.start(AsyncPollMs);
+}
+
+void AKApp::pollAsyncTasks() noexcept
+{
+    // Extracted first since onDone() may queue more tasks
+    std::vector<std::function<void()>> finished;
+
+    std::erase_if(m_asyncTasks, [&finished](AsyncTask &task) {
+        if (task.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return false;
+
+        if (task.onDone)
+            finished.emplace_back(std::move(task.onDone));
+
+        return true;
+    });
+
+    const bool pending { !m_asyncTasks.empty() };
+
+    for (auto &onDone : finished)
+        onDone();
+
+    if (pending)
+        m_asyncTimer.start(AsyncPollMs);
+}
+
+void AKApp::tickAnimations() noexcept
+{
+    if (m_animations.empty())
+        return;
+
+    const auto now { std::chrono::steady_clock::now() };
+
+    // Already ticked for this frame
+    if (now - m_frameTime < MinFrameInterval)
+        return;
+
+    m_frameTime = now;
+
+    // Callbacks may start, stop or destroy animations
+    std::vector<CZWeak<AKAnimation>> animations;
+    animations.reserve(m_animations.size());
+
+    for (AKAnimation *animation : m_animations)
+        animations.emplace_back(animation);
+
+    for (auto &animation : animations)
+        if (animation && animation->running())
+            animation->tick(now);
+}
+
+void AKApp::requestAnimationFrames() noexcept
+{
+    for (AKAnimation *animation : m_animations)
+        if (AKNode *node = animation->node())
+            node->repaint();
+}
+
+void AKApp::setMaxFps(UInt32 fps) noexcept
+{
+    if (m_maxFps == fps)
+        return;
+
+    m_maxFps = fps;
+
+    if (!m_frameQueue.empty())
+        armFrameTimer();
+}
+
+std::chrono::steady_clock::time_point AKApp::frameDeadline(const AKTarget *target) const noexcept
+{
+    if (m_maxFps == 0)
+        return target->m_lastFrameTime;
+
+    return target->m_lastFrameTime + std::chrono::microseconds(1000000 / m_maxFps);
+}
+
+void AKApp::scheduleFrame(AKTarget *target) noexcept
+{
+    if (target->m_frameRequested || target->m_waitingFrameDone)
+        return;
+
+    if (std::find(m_frameQueue.begin(), m_frameQueue.end(), target) != m_frameQueue.end())
+        return;
+
+    m_frameQueue.emplace_back(target);
+    armFrameTimer();
+}
+
+void AKApp::notifyAssetsReady() noexcept
+{
+    // Nodes may request again and fail, or be destroyed by another node's event
+    const std::vector<AKNode*> nodes { m_assetPendingNodes.begin(), m_assetPendingNodes.end() };
+
+    for (AKNode *node : nodes)
+        if (m_assetPendingNodes.contains(node))
+            node->assetsReadyEvent();
+}
+
+void AKApp::onFrameRendered(AKTarget *target) noexcept
+{
+    target->m_frameRequested = false;
+    target->m_lastFrameTime = std::chrono::steady_clock::now();
+    target->m_waitingFrameDone = target->m_frameFeedback;
+    std::erase(m_frameQueue, target);
+}
+
+void AKApp::armFrameTimer() noexcept
+{
+    auto deadline { frameDeadline(m_frameQueue.front()) };
+
+    for (const AKTarget *target : m_frameQueue)
+        deadline = std::min(deadline, frameDeadline(target));
+
+    // Even if already due, a zero timer coalesces all markDirty() calls of the current event loop iteration
+    const auto delay { std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count() };
+    m_frameTimer.start(delay > 0 ? UInt32(delay) : 0);
+}
+
+void AKApp::emitFrameRequests() noexcept
+{
+    const auto now { std::chrono::steady_clock::now() };
+    std::vector<CZWeak<AKTarget>> due;
+
+    std::erase_if(m_frameQueue, [&](AKTarget *target) {
+        if (frameDeadline(target) - now >= std::chrono::milliseconds(1))
+            return false;
+
+        target->m_frameRequested = true;
+        due.emplace_back(target);
+        return true;
+    });
+
+    if (!m_frameQueue.empty())
+        armFrameTimer();
+
+    // Handlers may render or destroy targets
+    for (auto &target : due)
+        if (target)
+            target->onFrameRequest.notify(*target);
+}
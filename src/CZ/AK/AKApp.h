@@ -4,8 +4,13 @@
 #include <CZ/AK/Input/AKPointer.h>
 #include <CZ/AK/Input/AKKeyboard.h>
 #include <CZ/Core/Cuarzo.h>
+#include <CZ/Core/CZTimer.h>
 #include <CZ/Ream/Ream.h>
 #include <CZ/skia/modules/skparagraph/include/FontCollection.h>
+#include <functional>
+#include <unordered_set>
+#include <future>
+#include <chrono>
 
 /**
  * @brief Core application class
@@ -35,24 +40,144 @@ public:
     std::shared_ptr<CZCore> core() const noexcept { return m_cuarzo; }
     std::shared_ptr<RCore> ream() const noexcept { return m_ream; }
 
+    /**
+     * @brief Font manager (fontconfig).
+     *
+     * Created on first use, which can take a while on systems with many fonts.
+     * Waits for preloadFonts() if it is still in progress.
+     */
     sk_sp<SkFontMgr> fontManager() const noexcept;
+
+    /**
+     * @brief Font collection with font fallback, created on first use.
+     */
     sk_sp<skia::textlayout::FontCollection> fontCollection() const noexcept;
 
+    /**
+     * @brief Starts creating the font manager on a worker thread.
+     *
+     * Can be called right after creating the app so that fontconfig initializes while
+     * the rest of the UI is being set up. Does nothing if the font manager already exists.
+     */
+    void preloadFonts() noexcept;
+
+    /**
+     * @brief A step of the startup profile.
+     */
+    struct StartupStep
+    {
+        std::string name;
+        std::chrono::microseconds duration;
+        bool background; ///< Whether it ran on a worker thread
+    };
+
+    /**
+     * @brief Time spent on each initialization step.
+     *
+     * Includes the font manager, font collection, theme and icon font creation, and the time
+     * elapsed until the first AKScene::render() call finishes ("First frame").
+     * The startupReport() is logged with CZDebug level after the first frame.
+     */
+    const std::vector<StartupStep> &startupProfile() const noexcept { return m_startupProfile; }
+
+    /**
+     * @brief Adds a custom step to the startup profile.
+     */
+    void addStartupStep(const std::string &name, std::chrono::microseconds duration, bool background = false) const noexcept;
+
+    /**
+     * @brief Human readable table of the startup profile.
+     */
+    std::string startupReport() const noexcept;
+
     AKPointer &pointer() noexcept { return m_pointer; };
     AKKeyboard &keyboard() noexcept;
+
+    /**
+     * @brief Runs a task on a worker thread.
+     *
+     * The task must not access nodes, scenes or Ream resources.
+     *
+     * @param task Function executed on a worker thread.
+     * @param onDone Optional function called from the main thread once the task finishes.
+     */
+    void runAsync(std::function<void()> task, std::function<void()> onDone = {}) noexcept;
+
+    /**
+     * @brief Timestamp shared by all AKAnimations ticked in the current frame.
+     */
+    std::chrono::steady_clock::time_point frameTime() const noexcept { return m_frameTime; }
+
+    /**
+     * @brief Currently running animations.
+     */
+    const std::vector<AKAnimation*> &animations() const noexcept { return m_animations; }
+
+    /**
+     * @brief Maximum rate at which AKTarget::onFrameRequest is emitted for each target.
+     *
+     * 0 means unlimited (default), frames are then requested as soon as a target is marked dirty
+     * or, with frame feedback enabled, as soon as the previous frame is done.
+     */
+    void setMaxFps(UInt32 fps) noexcept;
+    UInt32 maxFps() const noexcept { return m_maxFps; }
 protected:
     bool event(const CZEvent &event) noexcept override;
 private:
     friend class AKScene;
+    friend class AKTarget;
     friend class AKAnimation;
+    friend class AKNode;
+    friend class AKTheme;
+    friend void setTheme(AKTheme *theme) noexcept;
     AKApp(std::shared_ptr<CZCore> cuarzo, std::shared_ptr<RCore> ream) noexcept;
     void setKeyboard(AKKeyboard *keyboard) noexcept;
+    void pollAsyncTasks() noexcept;
+    void onFirstFrame() noexcept;
+    void tickAnimations() noexcept;
+    void requestAnimationFrames() noexcept;
+    void scheduleFrame(AKTarget *target) noexcept;
+    void notifyAssetsReady() noexcept;
+    void onFrameRendered(AKTarget *target) noexcept;
+    void armFrameTimer() noexcept;
+    void emitFrameRequests() noexcept;
+    std::chrono::steady_clock::time_point frameDeadline(const AKTarget *target) const noexcept;
+
+    // Interval at which finished async tasks are checked
+    static constexpr UInt32 AsyncPollMs { 4 };
+
+    // Renders closer than this are considered the same frame (e.g. multiple targets)
+    static constexpr std::chrono::microseconds MinFrameInterval { 1000 };
+
+    struct AsyncTask
+    {
+        std::future<void> future;
+        std::function<void()> onDone;
+    };
+
     std::shared_ptr<CZCore> m_cuarzo;
     std::shared_ptr<RCore> m_ream;
     AKPointer m_pointer;
     std::unique_ptr<AKKeyboard> m_keyboard;
-    sk_sp<SkFontMgr> m_fontManager;
-    sk_sp<skia::textlayout::FontCollection> m_fontCollection;
+    // Created lazily
+    mutable sk_sp<SkFontMgr> m_fontManager;
+    mutable sk_sp<skia::textlayout::FontCollection> m_fontCollection;
+    mutable std::future<std::pair<sk_sp<SkFontMgr>, std::chrono::microseconds>> m_fontManagerFuture;
+    mutable std::vector<StartupStep> m_startupProfile;
+    std::chrono::steady_clock::time_point m_startTime { std::chrono::steady_clock::now() };
+    bool m_firstFrameDone { false };
+    std::vector<AsyncTask> m_asyncTasks;
+    CZTimer m_asyncTimer;
+    std::vector<AKAnimation*> m_animations;
+    std::chrono::steady_clock::time_point m_frameTime {};
+
+    // Dirty targets waiting for their frame deadline
+    std::vector<AKTarget*> m_frameQueue;
+    CZTimer m_frameTimer;
+    UInt32 m_maxFps { 0 };
+
+    // See AKNode::setAssetPending(), kept here since the theme can be replaced
+    std::unordered_set<AKNode*> m_assetPendingNodes;
 };
 
 #endif // CZ_AKAPPLICATION_H
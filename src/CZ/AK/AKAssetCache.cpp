@@ -0,0 +1,341 @@
+#include <CZ/AK/AKAssetCache.h>
+#include <CZ/AK/AKLog.h>
+
+#include <CZ/Ream/RCore.h>
+#include <CZ/Ream/RDevice.h>
+#include <CZ/Ream/RImage.h>
+#include <CZ/Ream/SK/RSKFormat.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <cstdio>
+
+using namespace CZ;
+
+// Bump when DiskHeader or the pixel layout changes
+static constexpr UInt32 DiskFormat { 1 };
+static constexpr UInt32 DiskMagic { 0x41594B41 }; // "AKYA"
+
+struct DiskHeader
+{
+    UInt32 magic;
+    UInt32 format;
+    UInt32 kind;
+    Int32 width;
+    Int32 height;
+    UInt32 stride;
+    Int64 params[6];
+};
+
+size_t AKAssetCache::KeyHash::operator()(const Key &key) const noexcept
+{
+    size_t hash { std::hash<UInt8>{}(UInt8(key.kind)) };
+
+    for (const auto param : key.params)
+        hash ^= std::hash<Int64>{}(param) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+
+    return hash;
+}
+
+size_t AKAssetCache::ImageBytes(const std::shared_ptr<RImage> &image) noexcept
+{
+    if (!image)
+        return 0;
+
+    return size_t(image->size().width()) * size_t(image->size().height()) * 4;
+}
+
+std::shared_ptr<void> AKAssetCache::find(const Key &key) noexcept
+{
+    auto &stats { m_stats[size_t(key.kind)] };
+    const auto it { m_entries.find(key) };
+
+    if (it == m_entries.end())
+    {
+        stats.misses++;
+        return {};
+    }
+
+    stats.hits++;
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->asset;
+}
+
+void AKAssetCache::add(const Key &key, std::shared_ptr<void> asset, size_t bytes) noexcept
+{
+    if (!asset)
+        return;
+
+    if (const auto it = m_entries.find(key); it != m_entries.end())
+    {
+        auto &stats { m_stats[size_t(key.kind)] };
+        stats.bytes -= it->second->bytes;
+        stats.assets--;
+        m_bytes -= it->second->bytes;
+        m_lru.erase(it->second);
+        m_entries.erase(it);
+    }
+
+    m_lru.emplace_front(key, std::move(asset), bytes);
+    m_entries[key] = m_lru.begin();
+    m_stats[size_t(key.kind)].bytes += bytes;
+    m_stats[size_t(key.kind)].assets++;
+    m_bytes += bytes;
+    enforceBudget();
+}
+
+void AKAssetCache::evict(std::list<Entry>::iterator it) noexcept
+{
+    auto &stats { m_stats[size_t(it->key.kind)] };
+    stats.evictions++;
+    stats.bytes -= it->bytes;
+    stats.assets--;
+    m_bytes -= it->bytes;
+    m_entries.erase(it->key);
+    m_lru.erase(it);
+}
+
+void AKAssetCache::enforceBudget() noexcept
+{
+    auto it { m_lru.end() };
+
+    while (m_bytes > m_memoryBudget && it != m_lru.begin())
+    {
+        --it;
+
+        // Still in use, evicting it wouldn't release memory
+        if (it->asset.use_count() > 1)
+            continue;
+
+        // Already visited, the next --it moves to the previous entry
+        auto next { std::next(it) };
+        evict(it);
+        it = next;
+    }
+}
+
+void AKAssetCache::setMemoryBudget(size_t bytes) noexcept
+{
+    m_memoryBudget = bytes;
+    enforceBudget();
+}
+
+AKAssetCache::Stats AKAssetCache::stats(Kind kind) const noexcept
+{
+    if (kind >= Kind::Count)
+        return {};
+
+    return m_stats[size_t(kind)];
+}
+
+AKAssetCache::Stats AKAssetCache::stats() const noexcept
+{
+    Stats total {};
+
+    for (const auto &stats : m_stats)
+    {
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.evictions += stats.evictions;
+        total.diskHits += stats.diskHits;
+        total.assets += stats.assets;
+        total.bytes += stats.bytes;
+    }
+
+    return total;
+}
+
+void AKAssetCache::resetStats() noexcept
+{
+    for (auto &stats : m_stats)
+    {
+        stats.hits = 0;
+        stats.misses = 0;
+        stats.evictions = 0;
+        stats.diskHits = 0;
+    }
+}
+
+void AKAssetCache::trim() noexcept
+{
+    for (auto it = m_lru.begin(); it != m_lru.end();)
+    {
+        if (it->asset.use_count() > 1)
+        {
+            ++it;
+            continue;
+        }
+
+        auto next { std::next(it) };
+        evict(it);
+        it = next;
+    }
+}
+
+std::filesystem::path AKAssetCache::DefaultDiskCacheDir() noexcept
+{
+    if (const char *xdg = getenv("XDG_CACHE_HOME"); xdg && xdg[0] == '/')
+        return std::filesystem::path(xdg) / "Kay" / "assets";
+
+    if (const char *home = getenv("HOME"); home && home[0] == '/')
+        return std::filesystem::path(home) / ".cache" / "Kay" / "assets";
+
+    return {};
+}
+
+bool AKAssetCache::enableDiskCache(UInt64 version, const std::filesystem::path &dir) noexcept
+{
+    m_diskDir.clear();
+    const auto root { dir.empty() ? DefaultDiskCacheDir() : dir };
+
+    if (root.empty())
+    {
+        AKLog(CZError, CZLN, "Failed to find a disk cache directory");
+        return false;
+    }
+
+    char versionName[17];
+    snprintf(versionName, sizeof(versionName), "%016llx", (unsigned long long)version);
+    std::error_code ec;
+    std::filesystem::create_directories(root / versionName, ec);
+
+    if (ec)
+    {
+        AKLog(CZError, CZLN, "Failed to create the disk cache directory {}: {}", (root / versionName).c_str(), ec.message());
+        return false;
+    }
+
+    // Remove assets of other versions
+    for (const auto &entry : std::filesystem::directory_iterator(root, ec))
+    {
+        const auto name { entry.path().filename().string() };
+
+        if (name != versionName && name.size() == sizeof(versionName) - 1 && entry.is_directory(ec) &&
+            name.find_first_not_of("0123456789abcdef") == std::string::npos)
+            std::filesystem::remove_all(entry.path(), ec);
+    }
+
+    m_diskDir = root / versionName;
+    return true;
+}
+
+std::filesystem::path AKAssetCache::diskPath(const Key &key) const noexcept
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%u-%016llx.px", UInt32(key.kind), (unsigned long long)KeyHash{}(key));
+    return m_diskDir / name;
+}
+
+std::shared_ptr<RImage> AKAssetCache::loadImage(const Key &key) noexcept
+{
+    if (!diskCacheEnabled())
+        return {};
+
+    const int fd { open(diskPath(key).c_str(), O_RDONLY | O_CLOEXEC) };
+
+    if (fd < 0)
+        return {};
+
+    struct stat st {};
+
+    if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(DiskHeader))
+    {
+        close(fd);
+        return {};
+    }
+
+    void *map { mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) };
+    close(fd);
+
+    if (map == MAP_FAILED)
+        return {};
+
+    std::shared_ptr<RImage> image;
+    const auto *header { static_cast<const DiskHeader*>(map) };
+
+    // Validate everything, the file may be truncated or belong to a colliding key
+    if (header->magic == DiskMagic &&
+        header->format == DiskFormat &&
+        header->kind == UInt32(key.kind) &&
+        std::memcmp(header->params, key.params.data(), sizeof(header->params)) == 0 &&
+        header->width > 0 && header->height > 0 &&
+        header->stride >= UInt32(header->width) * 4 &&
+        size_t(st.st_size) >= sizeof(DiskHeader) + size_t(header->stride) * size_t(header->height))
+    {
+        const auto info { SkImageInfo::Make(header->width, header->height, RSKFormat::FromDRM(DRM_FORMAT_ARGB8888), kPremul_SkAlphaType) };
+        image = MakeImage(SkPixmap(info, static_cast<const UInt8*>(map) + sizeof(DiskHeader), header->stride));
+    }
+
+    munmap(map, st.st_size);
+
+    if (image)
+        m_stats[size_t(key.kind)].diskHits++;
+
+    return image;
+}
+
+void AKAssetCache::storePixels(const Key &key, const SkPixmap &pixmap) noexcept
+{
+    if (!diskCacheEnabled() || !pixmap.addr() || pixmap.width() <= 0 || pixmap.height() <= 0)
+        return;
+
+    DiskHeader header {};
+    header.magic = DiskMagic;
+    header.format = DiskFormat;
+    header.kind = UInt32(key.kind);
+    header.width = pixmap.width();
+    header.height = pixmap.height();
+    header.stride = pixmap.rowBytes();
+    std::memcpy(header.params, key.params.data(), sizeof(header.params));
+
+    // Written to a temporary file and then renamed, so readers never see a partial file
+    const auto path { diskPath(key) };
+    const auto tmpPath { std::filesystem::path(path).concat("." + std::to_string(getpid()) + ".tmp") };
+    const int fd { open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) };
+
+    if (fd < 0)
+        return;
+
+    const size_t pixelsSize { size_t(header.stride) * size_t(header.height) };
+    bool ok { write(fd, &header, sizeof(header)) == ssize_t(sizeof(header)) };
+    ok = ok && write(fd, pixmap.addr(), pixelsSize) == ssize_t(pixelsSize);
+    close(fd);
+
+    if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        AKLog(CZWarning, CZLN, "Failed to store asset in the disk cache: {}", path.c_str());
+        unlink(tmpPath.c_str());
+    }
+}
+
+std::shared_ptr<RImage> AKAssetCache::MakeImage(const SkPixmap &pixmap) noexcept
+{
+    auto *mainDevice { RCore::Get()->mainDevice() };
+    const auto fmt { mainDevice->textureFormats().formats().find(DRM_FORMAT_ARGB8888) };
+
+    if (fmt == mainDevice->textureFormats().formats().end())
+    {
+        AKLog(CZError, CZLN, "The main device doesn't support DRM_FORMAT_ARGB8888 textures");
+        return {};
+    }
+
+    RPixelBufferInfo pixInfo {};
+    pixInfo.pixels = (UInt8*)pixmap.addr();
+    pixInfo.stride = pixmap.rowBytes();
+    pixInfo.format = DRM_FORMAT_ARGB8888;
+    pixInfo.size = pixmap.dimensions();
+
+    RImageConstraints cons {};
+    cons.allocator = mainDevice;
+    cons.caps[mainDevice] = RImageCap_Src | RImageCap_SkImage;
+
+    auto image { RImage::MakeFromPixels(pixInfo, *fmt, &cons) };
+
+    if (!image)
+        AKLog(CZError, CZLN, "Failed to create RImage from pixels");
+
+    return image;
+}
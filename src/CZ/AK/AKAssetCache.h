@@ -0,0 +1,200 @@
+#ifndef CZ_AKASSETCACHE_H
+#define CZ_AKASSETCACHE_H
+
+#include <CZ/AK/AK.h>
+#include <CZ/Ream/Ream.h>
+#include <CZ/skia/core/SkPixmap.h>
+#include <unordered_map>
+#include <filesystem>
+#include <memory>
+#include <tuple>
+#include <array>
+#include <list>
+
+/**
+ * @brief Keyed cache of generated assets.
+ *
+ * Used by AKTheme to store the images it generates (three-patches, nine-patches, masks, etc).
+ * Assets are evicted in least recently used order when the total size exceeds the memory budget.
+ *
+ * Assets still referenced outside the cache are never evicted, as doing so wouldn't release any memory.
+ *
+ * Optionally, the pixels of rasterized assets can also be stored on disk (see enableDiskCache()), so that
+ * later runs upload them directly instead of drawing them again.
+ */
+class CZ::AKAssetCache
+{
+public:
+    /**
+     * @brief Asset kinds, used for the statistics.
+     *
+     * AKTheme subclasses can use `Custom` for their own assets.
+     */
+    enum class Kind : UInt8
+    {
+        TextFieldPatch,
+        TextCaretPatch,
+        RoundLinePatch,
+        ScrollRailPatch,
+        EdgeShadow,
+        WindowButton,
+        CircleMask,
+        RRect9Patch,
+        Custom,
+        Count
+    };
+
+    /**
+     * @brief Asset key, a kind plus up to 6 parameters.
+     */
+    struct Key
+    {
+        Kind kind {};
+        std::array<Int64, 6> params {};
+        bool operator==(const Key &other) const noexcept = default;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const noexcept;
+    };
+
+    /**
+     * @brief Cache statistics.
+     */
+    struct Stats
+    {
+        UInt64 hits { 0 };      ///< Assets found in the cache
+        UInt64 misses { 0 };    ///< Assets that had to be generated
+        UInt64 evictions { 0 }; ///< Assets evicted due to the budget or trim()
+        UInt64 diskHits { 0 };  ///< Misses whose pixels were loaded from the disk cache
+        size_t assets { 0 };    ///< Assets currently in the cache
+        size_t bytes { 0 };     ///< Memory used by the cached assets
+    };
+
+    /**
+     * @brief Default memory budget (16 MiB).
+     */
+    static constexpr size_t DefaultMemoryBudget { 16 * 1024 * 1024 };
+
+    template<class... Params>
+    static Key MakeKey(Kind kind, Params... params) noexcept
+    {
+        static_assert(sizeof...(Params) <= std::tuple_size_v<decltype(Key::params)>);
+        return { kind, { static_cast<Int64>(params)... } };
+    }
+
+    /**
+     * @brief Memory used by an image, assuming 4 bytes per pixel.
+     */
+    static size_t ImageBytes(const std::shared_ptr<RImage> &image) noexcept;
+
+    /**
+     * @brief Finds an asset and marks it as the most recently used.
+     *
+     * @return The asset or nullptr if not cached. T must match the type used in add().
+     */
+    template<class T>
+    std::shared_ptr<T> get(const Key &key) noexcept
+    {
+        return std::static_pointer_cast<T>(find(key));
+    }
+
+    /**
+     * @brief Adds or replaces an asset.
+     *
+     * May evict other assets if the budget is exceeded.
+     *
+     * @param bytes Memory used by the asset.
+     */
+    void add(const Key &key, std::shared_ptr<void> asset, size_t bytes) noexcept;
+
+    /**
+     * @brief Sets the maximum memory used by the cached assets in bytes.
+     */
+    void setMemoryBudget(size_t bytes) noexcept;
+    size_t memoryBudget() const noexcept { return m_memoryBudget; }
+
+    /**
+     * @brief Statistics of a single kind.
+     */
+    Stats stats(Kind kind) const noexcept;
+
+    /**
+     * @brief Statistics of all kinds combined.
+     */
+    Stats stats() const noexcept;
+    void resetStats() noexcept;
+
+    /**
+     * @brief Enables the on-disk pixel cache.
+     *
+     * Files are stored under `dir/<version>`, directories of other versions are removed.
+     *
+     * @param version Identifies how the assets are drawn, e.g. AKTheme::assetsVersion().
+     * @param dir Cache directory, DefaultDiskCacheDir() if empty.
+     * @return true on success, false if the directory could not be created.
+     */
+    bool enableDiskCache(UInt64 version, const std::filesystem::path &dir = {}) noexcept;
+    void disableDiskCache() noexcept { m_diskDir.clear(); }
+    bool diskCacheEnabled() const noexcept { return !m_diskDir.empty(); }
+
+    /**
+     * @brief Default disk cache directory.
+     *
+     * `$XDG_CACHE_HOME/Kay/assets`, or `~/.cache/Kay/assets` if XDG_CACHE_HOME is not set.
+     */
+    static std::filesystem::path DefaultDiskCacheDir() noexcept;
+
+    /**
+     * @brief Creates an image from pixels stored in the disk cache.
+     *
+     * The file is memory-mapped and uploaded without intermediate copies.
+     *
+     * @return The image, or nullptr if not found or the disk cache is disabled.
+     */
+    std::shared_ptr<RImage> loadImage(const Key &key) noexcept;
+
+    /**
+     * @brief Stores pixels in the disk cache.
+     *
+     * Does nothing if the disk cache is disabled.
+     *
+     * @param pixmap Pixels in the format expected by MakeImage().
+     */
+    void storePixels(const Key &key, const SkPixmap &pixmap) noexcept;
+
+    /**
+     * @brief Uploads ARGB8888 premultiplied pixels into a new image.
+     */
+    static std::shared_ptr<RImage> MakeImage(const SkPixmap &pixmap) noexcept;
+
+    /**
+     * @brief Drops all assets not referenced outside the cache.
+     *
+     * Intended for low-memory situations. Assets are generated again on demand.
+     */
+    void trim() noexcept;
+private:
+    struct Entry
+    {
+        Key key;
+        std::shared_ptr<void> asset;
+        size_t bytes;
+    };
+
+    std::shared_ptr<void> find(const Key &key) noexcept;
+    std::filesystem::path diskPath(const Key &key) const noexcept;
+    void evict(std::list<Entry>::iterator it) noexcept;
+    void enforceBudget() noexcept;
+
+    // Front = most recently used
+    std::list<Entry> m_lru;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_entries;
+    std::array<Stats, size_t(Kind::Count)> m_stats {};
+    size_t m_bytes { 0 };
+    size_t m_memoryBudget { DefaultMemoryBudget };
+    std::filesystem::path m_diskDir;
+};
+
+#endif // CZ_AKASSETCACHE_H
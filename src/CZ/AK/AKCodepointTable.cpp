@@ -0,0 +1,134 @@
+#include <CZ/AK/AKCodepointTable.h>
+#include <CZ/AK/AKLog.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace CZ;
+
+static constexpr UInt32 TableMagic { 0x50434B41 }; // "AKCP"
+static constexpr UInt32 TableVersion { 1 };
+
+struct TableHeader
+{
+    UInt32 magic;
+    UInt32 version;
+    UInt32 count;
+    UInt32 bucketCount;
+    UInt32 stringsSize;
+};
+
+std::unique_ptr<AKCodepointTable> AKCodepointTable::Load(const std::filesystem::path &path) noexcept
+{
+    const int fd { open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+
+    if (fd < 0)
+        return {};
+
+    struct stat st {};
+
+    if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(TableHeader))
+    {
+        close(fd);
+        AKLog(CZError, CZLN, "Invalid codepoint table: {}", path.c_str());
+        return {};
+    }
+
+    void *map { mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) };
+    close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        AKLog(CZError, CZLN, "Failed to map codepoint table: {}", path.c_str());
+        return {};
+    }
+
+    std::unique_ptr<AKCodepointTable> table { new AKCodepointTable() };
+    table->m_map = map;
+    table->m_mapSize = st.st_size;
+
+    const auto *header { static_cast<const TableHeader*>(map) };
+    const size_t expectedSize {
+        sizeof(TableHeader) +
+        size_t(header->bucketCount) * sizeof(UInt32) +
+        size_t(header->count) * sizeof(Entry) +
+        size_t(header->stringsSize) };
+
+    if (header->magic != TableMagic ||
+        header->version != TableVersion ||
+        header->bucketCount == 0 ||
+        table->m_mapSize < expectedSize)
+    {
+        AKLog(CZError, CZLN, "Invalid codepoint table: {}", path.c_str());
+        return {};
+    }
+
+    const auto *data { static_cast<const char*>(map) + sizeof(TableHeader) };
+    table->m_count = header->count;
+    table->m_bucketCount = header->bucketCount;
+    table->m_buckets = reinterpret_cast<const UInt32*>(data);
+    data += size_t(header->bucketCount) * sizeof(UInt32);
+    table->m_entries = reinterpret_cast<const Entry*>(data);
+    data += size_t(header->count) * sizeof(Entry);
+    table->m_strings = data;
+    table->m_stringsSize = header->stringsSize;
+    return table;
+}
+
+AKCodepointTable::~AKCodepointTable() noexcept
+{
+    if (m_map)
+        munmap(m_map, m_mapSize);
+}
+
+UInt64 AKCodepointTable::Hash(std::string_view name, UInt64 seed) noexcept
+{
+    // FNV-1a with a seeded basis and a final avalanche step
+    UInt64 hash { 0xCBF29CE484222325ULL ^ (seed * 0x9E3779B97F4A7C15ULL) };
+
+    for (const auto c : name)
+    {
+        hash ^= UInt8(c);
+        hash *= 0x100000001B3ULL;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+const AKCodepointTable::Entry *AKCodepointTable::find(std::string_view iconName) const noexcept
+{
+    if (m_count == 0)
+        return nullptr;
+
+    const UInt32 seed { m_buckets[Hash(iconName, 0) % m_bucketCount] };
+    const Entry &entry { m_entries[Hash(iconName, seed) % m_count] };
+
+    // The perfect hash only covers known names, so the name must still be compared
+    if (entry.nameLength != iconName.size() ||
+        size_t(entry.nameOffset) + entry.nameLength > m_stringsSize ||
+        iconName.compare(0, iconName.size(), m_strings + entry.nameOffset, entry.nameLength) != 0)
+        return nullptr;
+
+    return &entry;
+}
+
+std::string_view AKCodepointTable::findUTF8(std::string_view iconName) const noexcept
+{
+    const auto *entry { find(iconName) };
+
+    if (!entry || entry->utf8Length > sizeof(entry->utf8))
+        return {};
+
+    return { entry->utf8, entry->utf8Length };
+}
+
+UInt32 AKCodepointTable::findCodepoint(std::string_view iconName) const noexcept
+{
+    const auto *entry { find(iconName) };
+    return entry ? entry->codepoint : 0;
+}
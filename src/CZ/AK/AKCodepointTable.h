@@ -0,0 +1,78 @@
+#ifndef CZ_AKCODEPOINTTABLE_H
+#define CZ_AKCODEPOINTTABLE_H
+
+#include <CZ/AK/AK.h>
+#include <string_view>
+#include <filesystem>
+#include <memory>
+
+/**
+ * @brief Memory-mapped icon name to codepoint table.
+ *
+ * Binary alternative to `.codepoints` files, generated at build time by `scripts/codepoints/gen_codepoint_table.py`.
+ * Names are looked up through a minimal perfect hash directly in the mapped file, so lookups don't allocate
+ * and loading doesn't require parsing.
+ */
+class CZ::AKCodepointTable
+{
+public:
+    /**
+     * @brief Maps a table file.
+     *
+     * @return The table, or nullptr if the file could not be mapped or is not a valid table.
+     */
+    static std::unique_ptr<AKCodepointTable> Load(const std::filesystem::path &path) noexcept;
+
+    ~AKCodepointTable() noexcept;
+
+    /**
+     * @brief Finds the UTF-8 encoded codepoint of an icon.
+     *
+     * @return A view into the mapped file, or an empty view if not found.
+     */
+    std::string_view findUTF8(std::string_view iconName) const noexcept;
+
+    /**
+     * @brief Finds the codepoint of an icon.
+     *
+     * @return The codepoint or 0 if not found.
+     */
+    UInt32 findCodepoint(std::string_view iconName) const noexcept;
+
+    bool contains(std::string_view iconName) const noexcept { return find(iconName) != nullptr; }
+
+    /**
+     * @brief Number of icons.
+     */
+    UInt32 size() const noexcept { return m_count; }
+
+    /**
+     * @brief Name hash, must match the one used by the generator.
+     */
+    static UInt64 Hash(std::string_view name, UInt64 seed) noexcept;
+
+private:
+    struct Entry
+    {
+        UInt32 nameOffset;
+        UInt16 nameLength;
+        UInt8 utf8Length;
+        UInt8 pad;
+        char utf8[4];
+        UInt32 codepoint;
+    };
+
+    AKCodepointTable() noexcept = default;
+    const Entry *find(std::string_view iconName) const noexcept;
+
+    void *m_map { nullptr };
+    size_t m_mapSize { 0 };
+    UInt32 m_count { 0 };
+    UInt32 m_bucketCount { 0 };
+    const UInt32 *m_buckets { nullptr };
+    const Entry *m_entries { nullptr };
+    const char *m_strings { nullptr };
+    UInt32 m_stringsSize { 0 };
+};
+
+#endif // CZ_AKCODEPOINTTABLE_H
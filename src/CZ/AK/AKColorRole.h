@@ -1,6 +1,8 @@
 #ifndef AKCOLORROLE_H
 #define AKCOLORROLE_H
 
+#include <cstddef>
+
 namespace CZ
 {
     enum class AKColorRole
@@ -73,6 +75,9 @@ namespace CZ
         OnTertiaryFixed,
         OnTertiaryFixedVariant,
     };
+
+    /* Number of AKColorRole values */
+    inline constexpr size_t AKColorRoleCount { static_cast<size_t>(AKColorRole::OnTertiaryFixedVariant) + 1 };
 }
 
 #endif // AKCOLORROLE_H
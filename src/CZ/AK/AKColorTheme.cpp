@@ -1,21 +1,137 @@
 #include <CZ/AK/AKColorTheme.h>
+#include <CZ/AK/AKApp.h>
+#include <CZ/AK/AKLog.h>
+#include <CZ/AK/ThirdParty/Material/quantize/celebi.h>
+#include <CZ/AK/ThirdParty/Material/score/score.h>
+#include <CZ/AK/ThirdParty/Material/scheme/scheme_content.h>
+#include <CZ/AK/ThirdParty/Material/scheme/scheme_expressive.h>
+#include <CZ/AK/ThirdParty/Material/scheme/scheme_fidelity.h>
+#include <CZ/AK/ThirdParty/Material/scheme/scheme_fruit_salad.h>
+#include <CZ/AK/ThirdParty/Material/scheme/scheme_monochrome.h>
+#include <CZ/AK/ThirdParty/Material/scheme/scheme_neutral.h>
+#include <CZ/AK/ThirdParty/Material/scheme/scheme_rainbow.h>
+#include <CZ/AK/ThirdParty/Material/scheme/scheme_tonal_spot.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 using namespace CZ;
 using namespace material_color_utilities;
 
-std::shared_ptr<AKColorTheme> CZ::AKColorTheme::MakeFromColor(SkColor color) noexcept
+static DynamicScheme MakeScheme(const Hct &source, Variant variant, double contrast, bool dark) noexcept
 {
-    const auto SourceHCT = Hct(color);
-    const auto primary = TonalPalette(SourceHCT.get_hue(), 48.0);
-    const auto secondary = TonalPalette(SourceHCT.get_hue(), 16.0);
-    const auto tertiary = TonalPalette(SourceHCT.get_hue() + 60, 24.0);
-    const auto neutral = TonalPalette(SourceHCT.get_hue(), 4.0);
-    const auto neutralVar = TonalPalette(SourceHCT.get_hue(), 8.0);
+    switch (variant)
+    {
+    case Variant::kMonochrome: return SchemeMonochrome(source, dark, contrast);
+    case Variant::kNeutral:    return SchemeNeutral(source, dark, contrast);
+    case Variant::kTonalSpot:  return SchemeTonalSpot(source, dark, contrast);
+    case Variant::kExpressive: return SchemeExpressive(source, dark, contrast);
+    case Variant::kFidelity:   return SchemeFidelity(source, dark, contrast);
+    case Variant::kContent:    return SchemeContent(source, dark, contrast);
+    case Variant::kRainbow:    return SchemeRainbow(source, dark, contrast);
+    case Variant::kFruitSalad: return SchemeFruitSalad(source, dark, contrast);
+    case Variant::kVibrant:    break;
+    }
+
+    const auto primary = TonalPalette(source.get_hue(), 48.0);
+    const auto secondary = TonalPalette(source.get_hue(), 16.0);
+    const auto tertiary = TonalPalette(source.get_hue() + 60, 24.0);
+    const auto neutral = TonalPalette(source.get_hue(), 4.0);
+    const auto neutralVar = TonalPalette(source.get_hue(), 8.0);
     const auto error = TonalPalette(25.0, 84.0);
+    return DynamicScheme(source, Variant::kVibrant, contrast, dark, primary, secondary, tertiary, neutral, neutralVar, error);
+}
+
+std::shared_ptr<AKColorTheme> CZ::AKColorTheme::MakeFromColor(SkColor color, Variant variant, double contrast) noexcept
+{
+    // Weak references, themes are destroyed once no node uses them
+    static std::mutex mutex;
+    static std::map<std::tuple<SkColor, Variant, double>, std::weak_ptr<AKColorTheme>> cache;
+
+    // NaN breaks the map ordering, and -0.0 would be a different key than 0.0 for the same theme
+    if (std::isnan(contrast))
+    {
+        AKLog(CZWarning, CZLN, "Invalid contrast (NaN), using 0");
+        contrast = 0.0;
+    }
+    else
+        contrast = std::clamp(contrast, -1.0, 1.0) + 0.0;
+
+    const std::lock_guard lock { mutex };
+    const auto key { std::make_tuple(color, variant, contrast) };
 
-    return std::shared_ptr<AKColorTheme>(new AKColorTheme(
-        DynamicScheme(SourceHCT, Variant::kVibrant, 0.0, false, primary, secondary, tertiary, neutral, neutralVar, error),
-        DynamicScheme(SourceHCT, Variant::kVibrant, 0.0, true, primary, secondary, tertiary, neutral, neutralVar, error)));
+    if (auto it = cache.find(key); it != cache.end())
+        if (auto theme = it->second.lock())
+            return theme;
+
+    std::erase_if(cache, [](const auto &entry) { return entry.second.expired(); });
+
+    const auto SourceHCT = Hct(color);
+    auto theme { std::shared_ptr<AKColorTheme>(new AKColorTheme(
+        MakeScheme(SourceHCT, variant, contrast, false),
+        MakeScheme(SourceHCT, variant, contrast, true))) };
+    theme->m_seedColor = color;
+    theme->m_variant = variant;
+    theme->m_contrast = contrast;
+    cache[key] = theme;
+    return theme;
+}
+
+bool AKColorTheme::MakeFromImage(const SkPixmap &pixmap, std::function<void (std::shared_ptr<AKColorTheme>)> callback, Variant variant, double contrast) noexcept
+{
+    auto app { AKApp::Get() };
+
+    if (!app)
+    {
+        AKLog(CZError, CZLN, "Missing AKApp");
+        return false;
+    }
+
+    if (!pixmap.addr() || pixmap.width() <= 0 || pixmap.height() <= 0)
+    {
+        AKLog(CZError, CZLN, "Invalid pixmap");
+        return false;
+    }
+
+    // Samples the center of each block, the quantizer doesn't need more detail
+    const Int32 w { std::min(pixmap.width(), ImageSampleSize) };
+    const Int32 h { std::min(pixmap.height(), ImageSampleSize) };
+    auto pixels { std::make_shared<std::vector<Argb>>() };
+    pixels->reserve(w * h);
+
+    for (Int32 y = 0; y < h; y++)
+    {
+        const Int32 srcY { Int32((2 * Int64(y) + 1) * pixmap.height() / (2 * h)) };
+
+        for (Int32 x = 0; x < w; x++)
+            pixels->push_back(pixmap.getColor(Int32((2 * Int64(x) + 1) * pixmap.width() / (2 * w)), srcY));
+    }
+
+    auto theme { std::make_shared<std::shared_ptr<AKColorTheme>>() };
+
+    app->runAsync([pixels, theme, variant, contrast] {
+        const auto quantized { QuantizeCelebi(*pixels, 128) };
+
+        // Always contains at least one color (fallback if none is suitable)
+        const auto ranked { RankedSuggestions(quantized.color_to_count) };
+        *theme = MakeFromColor(ranked.front(), variant, contrast);
+    },
+    [theme, callback = std::move(callback)] {
+        if (callback)
+            callback(*theme);
+    });
+
+    return true;
+}
+
+AKColorTheme::AKColorTheme(DynamicScheme light, DynamicScheme dark) noexcept :
+    m_scheme {std::move(light), std::move(dark)}
+{
+    for (size_t s = 0; s < 2; s++)
+        for (size_t role = 0; role < AKColorRoleCount; role++)
+            m_colors[s][role] = m_scheme[s].GetColor(static_cast<AKColorRole>(role));
 }
 
 const DynamicScheme &AKColorTheme::scheme(CZColorScheme scheme) const noexcept
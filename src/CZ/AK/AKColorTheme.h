@@ -3,26 +3,84 @@
 
 #include <CZ/Core/CZColorScheme.h>
 #include <CZ/AK/AK.h>
+#include <CZ/AK/AKColorRole.h>
 #include <CZ/AK/ThirdParty/Material/dynamiccolor/dynamic_color.h>
+#include <CZ/AK/ThirdParty/Material/dynamiccolor/variant.h>
 #include <CZ/skia/core/SkColor.h>
+#include <CZ/skia/core/SkPixmap.h>
+#include <functional>
+#include <array>
 
 class CZ::AKColorTheme
 {
 public:
-    static std::shared_ptr<AKColorTheme> MakeFromColor(SkColor color) noexcept;
+    /**
+     * @brief Creates a theme from a seed color.
+     *
+     * Themes are interned: calls with the same (color, variant, contrast) return the same instance
+     * while it is alive, so nodes sharing an accent color share the theme object.
+     *
+     * @param color Seed color.
+     * @param variant Material scheme variant. kVibrant uses Kay's default palettes.
+     * @param contrast Contrast level from -1 (reduced) to 1 (high), 0 is the default. Clamped to that range, NaN is treated as 0.
+     */
+    static std::shared_ptr<AKColorTheme> MakeFromColor(SkColor color,
+        material_color_utilities::Variant variant = material_color_utilities::Variant::kVibrant,
+        double contrast = 0.0) noexcept;
+
+    /**
+     * @brief Maximum width and height images are downsampled to before extracting colors.
+     */
+    static constexpr Int32 ImageSampleSize { 112 };
+
+    /**
+     * @brief Creates a theme from the most suitable accent color of an image, asynchronously.
+     *
+     * The pixmap is downsampled on the calling thread, so it doesn't need to outlive the call.
+     * Quantization (Wu + WSMeans) and scoring run on a worker thread, see AKApp::runAsync().
+     *
+     * @param pixmap Source pixels (any color type).
+     * @param callback Called from the main thread with the resulting theme.
+     * @param variant See MakeFromColor().
+     * @param contrast See MakeFromColor().
+     * @return `false` if the pixmap is empty or there is no AKApp, in which case the callback is never called.
+     */
+    static bool MakeFromImage(const SkPixmap &pixmap,
+        std::function<void(std::shared_ptr<AKColorTheme>)> callback,
+        material_color_utilities::Variant variant = material_color_utilities::Variant::kVibrant,
+        double contrast = 0.0) noexcept;
+
+    SkColor seedColor() const noexcept { return m_seedColor; }
+    material_color_utilities::Variant variant() const noexcept { return m_variant; }
+    double contrast() const noexcept { return m_contrast; }
 
     const material_color_utilities::DynamicScheme &scheme(CZColorScheme scheme) const noexcept;
     const material_color_utilities::DynamicScheme &light() const noexcept { return m_scheme[0]; }
     const material_color_utilities::DynamicScheme &dark() const noexcept { return m_scheme[1]; }
 
+    /**
+     * @brief Gets the color of a role.
+     *
+     * All roles are resolved once when the theme is created, so this is a simple table lookup.
+     * Prefer it over the DynamicScheme getters, which re-evaluate the color pipeline on each call.
+     */
+    SkColor color(AKColorRole role, CZColorScheme scheme) const noexcept
+    {
+        return m_colors[scheme == CZColorScheme::Dark][static_cast<size_t>(role)];
+    }
+
 private:
     AKColorTheme(
         material_color_utilities::DynamicScheme light,
-        material_color_utilities::DynamicScheme dark) noexcept :
-        m_scheme {std::move(light), std::move(dark)}
-    {}
+        material_color_utilities::DynamicScheme dark) noexcept;
 
     material_color_utilities::DynamicScheme m_scheme[2];
+
+    // [light/dark][role]
+    std::array<SkColor, AKColorRoleCount> m_colors[2];
+    SkColor m_seedColor {};
+    material_color_utilities::Variant m_variant { material_color_utilities::Variant::kVibrant };
+    double m_contrast { 0.0 };
 };
 
 #endif // AKCOLORTHEME_H
@@ -10,6 +10,7 @@
 #include <CZ/Ream/RPass.h>
 #include <CZ/Ream/RSurface.h>
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <string>
@@ -18,6 +19,24 @@ using namespace CZ;
 
 std::shared_ptr<AKIconFont> AKIconFont::Make(const std::string &fontFamily, const std::filesystem::path &codepoints) noexcept
 {
+    if (codepoints.extension() == ".bin")
+    {
+        auto table { AKCodepointTable::Load(codepoints) };
+
+        if (!table)
+        {
+            AKLog(CZError, CZLN, "Unable to load codepoint table: {}", codepoints.c_str());
+            return AKIconFont::Make(fontFamily);
+        }
+
+        auto iconFont { AKIconFont::Make(fontFamily) };
+
+        if (iconFont)
+            iconFont->m_codepointTable = std::move(table);
+
+        return iconFont;
+    }
+
     std::ifstream fileStream { codepoints };
 
     if (!fileStream)
@@ -61,18 +80,16 @@ std::shared_ptr<CZ::AKIconFont> AKIconFont::Make(const std::string &fontFamily,
 
 std::shared_ptr<RImage> AKIconFont::getIconByName(const std::string &iconName, UInt32 size) noexcept
 {
-    if (!hasCodepointMap())
-        return {};
+    const auto utf8 { codepointUTF8(iconName) };
 
-    auto utf8 { m_codepoints->find(iconName) };
-
-    if (utf8 == m_codepoints->end())
+    if (utf8.empty())
     {
-        AKLog(CZError, CZLN, "No codepoint found for the icon: {}", iconName);
+        if (hasCodepointMap())
+            AKLog(CZError, CZLN, "No codepoint found for the icon: {}", iconName);
         return {};
     }
 
-    return getIconByUTF8(utf8->second, size);
+    return getIconByUTF8(std::string(utf8), size);
 }
 
 std::shared_ptr<RImage> AKIconFont::getIconByUTF8(const std::string &utf8, UInt32 size) noexcept
@@ -80,10 +97,16 @@ std::shared_ptr<RImage> AKIconFont::getIconByUTF8(const std::string &utf8, UInt3
     if (size == 0)
         return {};
 
-    auto found { m_cache[utf8][size] };
+    auto &sizes { m_cache[utf8] };
+    auto found { sizes.find(size) };
 
-    if (auto lock = found.lock())
-        return lock;
+    if (found != sizes.end())
+    {
+        if (auto lock = found->second.lock())
+            return lock;
+
+        sizes.erase(found);
+    }
 
     auto surface { RSurface::Make(SkISize(size, size), 1, true) };
 
@@ -96,6 +119,311 @@ std::shared_ptr<RImage> AKIconFont::getIconByUTF8(const std::string &utf8, UInt3
     auto pass { surface->beginPass(RPassCap_SkCanvas) };
     auto *c { pass->getCanvas() };
     c->clear(SK_ColorTRANSPARENT);
+
+    if (!paintIcon(c, utf8, size))
+        return {};
+
+    pass.reset();
+
+    m_cache[utf8][size] = surface->image();
+    return surface->image();
+}
+
+AKIconFont::Icon AKIconFont::getAtlasIconByName(const std::string &iconName, UInt32 size) noexcept
+{
+    const auto utf8 { codepointUTF8(iconName) };
+
+    if (utf8.empty())
+    {
+        if (hasCodepointMap())
+            AKLog(CZError, CZLN, "No codepoint found for the icon: {}", iconName);
+        return {};
+    }
+
+    return getAtlasIconByUTF8(utf8, size);
+}
+
+AKIconFont::Icon AKIconFont::getAtlasIconByUTF8(std::string_view utf8, UInt32 size) noexcept
+{
+    if (size == 0)
+        return {};
+
+    m_atlasClock++;
+
+    if (auto sizes = m_atlas.find(utf8); sizes != m_atlas.end())
+    {
+        if (auto it = sizes->second.find(size); it != sizes->second.end())
+        {
+            m_stats.hits++;
+
+            for (auto &page : m_atlasPages)
+            {
+                if (page.id == it->second.pageId)
+                {
+                    page.lastUse = m_atlasClock;
+                    return makeIcon(page, it->second.src);
+                }
+            }
+        }
+    }
+
+    m_stats.misses++;
+    SkIPoint pos;
+    auto *page { findAtlasSpace(size, &pos) };
+
+    if (!page)
+        return {};
+
+    const SkIRect src { SkIRect::MakeXYWH(pos.x(), pos.y(), size, size) };
+    auto pass { page->surface->beginPass(RPassCap_SkCanvas) };
+    auto *c { pass->getCanvas() };
+    c->save();
+    c->clipIRect(src);
+    c->translate(src.x(), src.y());
+    const bool painted { paintIcon(c, utf8, size) };
+    c->restore();
+    pass.reset();
+
+    if (!painted)
+        return {};
+
+    page->lastUse = m_atlasClock;
+
+    // Looked up again since evicting a page may have erased the entry
+    m_atlas[std::string(utf8)][size] = { page->id, src };
+    return makeIcon(*page, src);
+}
+
+AKIconFont::Icon AKIconFont::makeIcon(AtlasPage &page, const SkIRect &src) noexcept
+{
+    auto ref { page.handles.lock() };
+
+    if (!ref)
+    {
+        ref = std::make_shared<const UInt64>(page.id);
+        page.handles = ref;
+    }
+
+    return { page.image, src, std::move(ref) };
+}
+
+AKIconFont::AtlasPage *AKIconFont::findAtlasSpace(Int32 size, SkIPoint *pos) noexcept
+{
+    // Keeps neighbour icons from bleeding into each other when filtered
+    constexpr Int32 padding { 1 };
+
+    if (size <= AtlasPageSize)
+    {
+        // The current shelf of any page first, so starting a new shelf doesn't strand the end of another
+        for (auto &page : m_atlasPages)
+        {
+            if (page.cursorX + size <= AtlasPageSize && page.shelfY + size <= AtlasPageSize)
+            {
+                pos->set(page.cursorX, page.shelfY);
+                page.cursorX += size + padding;
+                page.shelfHeight = std::max(page.shelfHeight, size + padding);
+                return &page;
+            }
+        }
+
+        for (auto &page : m_atlasPages)
+        {
+            const Int32 shelfY { page.shelfY + page.shelfHeight };
+
+            if (shelfY + size <= AtlasPageSize)
+            {
+                pos->set(0, shelfY);
+                page.shelfY = shelfY;
+                page.shelfHeight = size + padding;
+                page.cursorX = size + padding;
+                return &page;
+            }
+        }
+    }
+
+    // Oversized icons get a dedicated page
+    const Int32 pageSize { std::max(size, AtlasPageSize) };
+    const size_t pageBytes { size_t(pageSize) * size_t(pageSize) * 4 };
+
+    while (atlasBytes() + pageBytes > m_memoryBudget && evictAtlasPage()) {}
+
+    auto surface { RSurface::Make(SkISize(pageSize, pageSize), 1, true) };
+
+    if (!surface)
+    {
+        AKLog(CZError, CZLN, "Failed to create atlas page");
+        return nullptr;
+    }
+
+    // Cleared once, including the padding, cells are never reused
+    auto pass { surface->beginPass(RPassCap_SkCanvas) };
+    pass->getCanvas()->clear(SK_ColorTRANSPARENT);
+    pass.reset();
+
+    auto &page { m_atlasPages.emplace_back() };
+    page.surface = surface;
+    page.image = surface->image();
+    page.id = m_atlasPageIds++;
+    pos->set(0, 0);
+    page.cursorX = size + padding;
+    page.shelfHeight = size + padding;
+
+    // Dedicated pages don't receive more icons
+    if (size > AtlasPageSize)
+        page.shelfY = pageSize;
+
+    return &page;
+}
+
+bool AKIconFont::evictAtlasPage() noexcept
+{
+    auto lru { m_atlasPages.end() };
+
+    for (auto it = m_atlasPages.begin(); it != m_atlasPages.end(); it++)
+    {
+        // Icons still held by handles, evicting it wouldn't release any memory
+        if (!it->handles.expired())
+            continue;
+
+        if (lru == m_atlasPages.end() || it->lastUse < lru->lastUse)
+            lru = it;
+    }
+
+    if (lru == m_atlasPages.end())
+        return false;
+
+    const UInt64 id { lru->id };
+    m_atlasPages.erase(lru);
+    m_stats.evictions++;
+
+    for (auto it = m_atlas.begin(); it != m_atlas.end();)
+    {
+        std::erase_if(it->second, [id](const auto &entry) { return entry.second.pageId == id; });
+
+        if (it->second.empty())
+            it = m_atlas.erase(it);
+        else
+            ++it;
+    }
+
+    return true;
+}
+
+size_t AKIconFont::atlasBytes() const noexcept
+{
+    size_t bytes { 0 };
+
+    for (const auto &page : m_atlasPages)
+    {
+        const SkISize size { page.surface->image()->size() };
+        bytes += size_t(size.width()) * size_t(size.height()) * 4;
+    }
+
+    return bytes;
+}
+
+void AKIconFont::setMemoryBudget(size_t bytes) noexcept
+{
+    m_memoryBudget = bytes;
+
+    while (atlasBytes() > m_memoryBudget && evictAtlasPage()) {}
+}
+
+void AKIconFont::prewarm(const std::vector<std::string> &iconNames, const std::vector<UInt32> &sizes, const std::vector<Int32> &scales, bool idle) noexcept
+{
+    for (const auto &name : iconNames)
+    {
+        if (!hasCodepointMap())
+            break;
+
+        const auto utf8 { codepointUTF8(name) };
+
+        if (utf8.empty())
+        {
+            AKLog(CZWarning, CZLN, "No codepoint found for the icon: {}", name);
+            continue;
+        }
+
+        for (auto size : sizes)
+            for (auto scale : scales)
+                if (size > 0 && scale > 0)
+                    m_prewarmQueue.emplace_back(utf8, size * UInt32(scale));
+    }
+
+    if (!idle)
+    {
+        while (!m_prewarmQueue.empty())
+            processPrewarmQueue();
+
+        m_prewarmTimer.stop();
+        return;
+    }
+
+    if (m_prewarmQueue.empty())
+        return;
+
+    m_prewarmTimer.setCallback([this](CZTimer *timer) {
+        processPrewarmQueue();
+
+        if (!m_prewarmQueue.empty())
+            timer->start(1);
+    });
+    m_prewarmTimer.start(1);
+}
+
+void AKIconFont::processPrewarmQueue() noexcept
+{
+    // Small enough to not be noticeable within a single loop iteration
+    constexpr size_t iconsPerSlice { 4 };
+
+    for (size_t i = 0; i < iconsPerSlice && !m_prewarmQueue.empty(); i++)
+    {
+        const auto &[utf8, size] { m_prewarmQueue.front() };
+        auto found { m_atlas.find(utf8) };
+
+        // Don't count prewarming as a hit
+        if (found == m_atlas.end() || !found->second.contains(size))
+            getAtlasIconByUTF8(utf8, size);
+
+        m_prewarmQueue.pop_front();
+    }
+}
+
+AKIconFont::Stats AKIconFont::stats() const noexcept
+{
+    Stats stats { m_stats };
+    stats.pages = m_atlasPages.size();
+    stats.bytes = atlasBytes();
+    stats.icons = 0;
+
+    for (const auto &sizes : m_atlas)
+        stats.icons += sizes.second.size();
+
+    return stats;
+}
+
+void AKIconFont::resetStats() noexcept
+{
+    m_stats = {};
+}
+
+void AKIconFont::trim() noexcept
+{
+    while (evictAtlasPage()) {}
+
+    for (auto it = m_cache.begin(); it != m_cache.end();)
+    {
+        std::erase_if(it->second, [](const auto &entry) { return entry.second.expired(); });
+
+        if (it->second.empty())
+            it = m_cache.erase(it);
+        else
+            ++it;
+    }
+}
+
+bool AKIconFont::paintIcon(SkCanvas *c, std::string_view utf8, UInt32 size) noexcept
+{
     m_builder->Reset();
     SkPaint p;
     p.setBlendMode(SkBlendMode::kSrc);
@@ -105,19 +433,19 @@ std::shared_ptr<RImage> AKIconFont::getIconByUTF8(const std::string &utf8, UInt3
     m_style.setHeight(size);
     m_style.setFontSize(size);
     m_builder->pushStyle(m_style);
-    m_builder->addText(utf8.c_str());
+    m_builder->addText(utf8.data(), utf8.size());
     m_paragraph = m_builder->Build();
 
     if (!m_paragraph)
     {
         AKLog(CZError, CZLN, "Failed to create paragraph");
-        return {};
+        return false;
     }
 
     m_paragraph->layout(size);
 
     if (m_paragraph->getMaxIntrinsicWidth() <= 0 || m_paragraph->getHeight() <= 0)
-        return {};
+        return false;
 
     float scaleX = size / m_paragraph->getMaxIntrinsicWidth();
     float scaleY = size / m_paragraph->getHeight();
@@ -126,18 +454,24 @@ std::shared_ptr<RImage> AKIconFont::getIconByUTF8(const std::string &utf8, UInt3
     c->scale(scaleX, scaleY);
     m_paragraph->paint(c, 0, 0);
     c->restore();
-    pass.reset();
+    return true;
+}
 
-    m_cache[utf8][size] = surface->image();
-    return surface->image();
+bool AKIconFont::hasIconName(std::string_view iconName) const noexcept
+{
+    return !codepointUTF8(iconName).empty();
 }
 
-bool AKIconFont::hasIconName(const std::string &iconName) const noexcept
+std::string_view AKIconFont::codepointUTF8(std::string_view iconName) const noexcept
 {
-    if (m_codepoints.has_value())
-        return m_codepoints->contains(iconName);
+    if (m_codepointTable)
+        return m_codepointTable->findUTF8(iconName);
+
+    if (m_codepoints)
+        if (auto it = m_codepoints->find(std::string(iconName)); it != m_codepoints->end())
+            return it->second;
 
-    return false;
+    return {};
 }
 
 std::string AKIconFont::UTF8FromCodepoint(UInt32 cp) noexcept
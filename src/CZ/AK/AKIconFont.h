@@ -2,8 +2,12 @@
 #define CZ_AKICONFONT_H
 
 #include <CZ/AK/AKObject.h>
+#include <CZ/AK/AKCodepointTable.h>
 #include <CZ/Ream/Ream.h>
+#include <CZ/Core/CZTimer.h>
+#include <string_view>
 #include <optional>
+#include <deque>
 
 #include <CZ/skia/modules/skparagraph/src/ParagraphImpl.h>
 #include <CZ/skia/modules/skparagraph/src/ParagraphBuilderImpl.h>
@@ -17,6 +21,48 @@
 class CZ::AKIconFont final : public AKObject
 {
 public:
+    /**
+     * @brief Handle to an icon stored in an atlas page.
+     *
+     * The page image is shared by many icons, use `src` as the source rect when drawing it.
+     * The handle keeps the page image alive even after the page is evicted from the atlas.
+     *
+     * While any handle of a page exists the page is not evicted. Only handles count, copies of `image`
+     * (e.g. held by a render pass) don't, so keep the handle rather than the image.
+     */
+    struct Icon
+    {
+        std::shared_ptr<RImage> image;
+        SkIRect src {};
+        std::shared_ptr<const void> pageRef; ///< Shared by the handles of a page
+        explicit operator bool() const noexcept { return image != nullptr; }
+    };
+
+    /**
+     * @brief Size of the atlas pages in pixels (square).
+     *
+     * Icons that don't fit into a page get a dedicated page.
+     */
+    static constexpr Int32 AtlasPageSize { 512 };
+
+    /**
+     * @brief Default memory budget of the atlas (4 pages).
+     */
+    static constexpr size_t DefaultMemoryBudget { 4 * AtlasPageSize * AtlasPageSize * 4 };
+
+    /**
+     * @brief Atlas cache statistics.
+     */
+    struct Stats
+    {
+        UInt64 hits { 0 };      ///< Icons found in the atlas
+        UInt64 misses { 0 };    ///< Icons that had to be rasterized
+        UInt64 evictions { 0 }; ///< Evicted atlas pages
+        size_t icons { 0 };     ///< Icons currently in the atlas
+        size_t pages { 0 };     ///< Atlas pages currently alive
+        size_t bytes { 0 };     ///< Memory used by the atlas pages
+    };
+
     /**
      * @brief Creates an icon font from a font family and an optional codepoint map.
      *
@@ -25,8 +71,11 @@ public:
      *
      * Use `hasCodepointMap()` to check if the map was successfully loaded.
      *
+     * Files with the `.bin` extension are loaded as an AKCodepointTable (memory-mapped, no parsing),
+     * which is generated at build time for the `.codepoints` files shipped with Kay.
+     *
      * @param fontFamily The name of the font family.
-     * @param codepointsPath Path to a `.codepoints` file containing icon name and hex codepoint pairs.
+     * @param codepointsPath Path to a `.codepoints` file containing icon name and hex codepoint pairs, or a binary table.
      * @return A shared pointer to an AKIconFont instance, or `nullptr` on failure.
      */
     static std::shared_ptr<AKIconFont> Make(const std::string &fontFamily, const std::filesystem::path &codepointsPath) noexcept;
@@ -65,7 +114,70 @@ public:
      */
     std::shared_ptr<RImage> getIconByUTF8(const std::string &utf8, UInt32 size) noexcept;
 
-    bool hasCodepointMap() const noexcept { return m_codepoints != std::nullopt; }
+    /**
+     * @brief Gets an atlas-backed icon by its name.
+     *
+     * Unlike getIconByName(), icons are packed into shared atlas pages instead of having their own image.
+     *
+     * @param iconName The name of the icon as defined in the codepoints map.
+     * @param size The desired icon size (in pixels, square).
+     * @return A handle to the icon, empty if the icon cannot be found or rendered.
+     */
+    Icon getAtlasIconByName(const std::string &iconName, UInt32 size) noexcept;
+
+    /**
+     * @brief Gets an atlas-backed icon from a UTF-8 codepoint.
+     *
+     * @see getAtlasIconByName()
+     */
+    Icon getAtlasIconByUTF8(std::string_view utf8, UInt32 size) noexcept;
+
+    /**
+     * @brief Sets the maximum memory used by the atlas pages in bytes.
+     *
+     * When a new page would exceed the budget, the least recently used pages are evicted.
+     * Pages with icons still held by a handle are never evicted, since their memory wouldn't be released,
+     * so the budget can be exceeded if all of them are in use.
+     */
+    void setMemoryBudget(size_t bytes) noexcept;
+    size_t memoryBudget() const noexcept { return m_memoryBudget; }
+
+    /**
+     * @brief Rasterizes icons into the atlas ahead of time.
+     *
+     * Each icon is rendered for every combination of logical size and scale factor (pixel size = size * scale),
+     * e.g. before opening a menu for the first time.
+     *
+     * Icons are rendered during idle time, a few per event loop iteration, unless `idle` is false,
+     * in which case they are all rendered before returning. Rendering must happen on the main thread
+     * since atlas pages are GPU surfaces.
+     *
+     * @param iconNames Icon names as defined in the codepoints map.
+     * @param sizes Icon sizes in logical coordinates.
+     * @param scales Scale factors.
+     * @param idle Whether to spread the work across event loop iterations.
+     */
+    void prewarm(const std::vector<std::string> &iconNames, const std::vector<UInt32> &sizes, const std::vector<Int32> &scales, bool idle = true) noexcept;
+
+    /**
+     * @brief Number of icons waiting to be prewarmed.
+     */
+    size_t pendingPrewarm() const noexcept { return m_prewarmQueue.size(); }
+
+    /**
+     * @brief Gets the atlas cache statistics.
+     */
+    Stats stats() const noexcept;
+    void resetStats() noexcept;
+
+    /**
+     * @brief Drops all atlas pages and expired entries of the per-icon cache.
+     *
+     * Handles already returned remain valid.
+     */
+    void trim() noexcept;
+
+    bool hasCodepointMap() const noexcept { return m_codepointTable || m_codepoints != std::nullopt; }
 
     /**
      * @brief Checks if an icon name exists in the font.
@@ -75,7 +187,7 @@ public:
      * @param iconName The name of the icon to check (e.g., "account_circle").
      * @return `true` if the icon name exists in the font, `false` otherwise.
      */
-    bool hasIconName(const std::string &iconName) const noexcept;
+    bool hasIconName(std::string_view iconName) const noexcept;
 
     /**
      * @brief Converts a Unicode codepoint to a UTF-8 encoded string.
@@ -98,11 +210,68 @@ public:
     static std::optional<std::unordered_map<std::string, std::string>> ParseCodepoints(const char *input) noexcept;
 
 private:
+    struct AtlasPage
+    {
+        std::shared_ptr<RSurface> surface;
+        std::shared_ptr<RImage> image;
+        UInt64 id;
+
+        // Expired once no Icon handle of the page is left
+        std::weak_ptr<const void> handles;
+
+        // Shelf packing state
+        Int32 shelfY { 0 }, shelfHeight { 0 }, cursorX { 0 };
+
+        // Value of m_atlasClock when an icon of the page was last requested
+        UInt64 lastUse { 0 };
+    };
+
+    struct AtlasEntry
+    {
+        UInt64 pageId;
+        SkIRect src;
+    };
+
+    // Builds the paragraph of an icon and paints it into [0, 0, size, size]
+    bool paintIcon(SkCanvas *canvas, std::string_view utf8, UInt32 size) noexcept;
+
+    // UTF-8 codepoint of an icon name, empty if not found
+    std::string_view codepointUTF8(std::string_view iconName) const noexcept;
+
+    // Allows looking up m_atlas with string views
+    struct StringHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+    };
+    AtlasPage *findAtlasSpace(Int32 size, SkIPoint *pos) noexcept;
+    Icon makeIcon(AtlasPage &page, const SkIRect &src) noexcept;
+
+    // Evicts the least recently used page not in use, returns false if there is none
+    bool evictAtlasPage() noexcept;
+    size_t atlasBytes() const noexcept;
+    void processPrewarmQueue() noexcept;
+
+    std::vector<AtlasPage> m_atlasPages;
+
+    // [utf8 code point][size] = atlas entry
+    std::unordered_map<std::string,
+        std::unordered_map<UInt32, AtlasEntry>, StringHash, std::equal_to<>> m_atlas;
+    UInt64 m_atlasClock { 0 };
+    UInt64 m_atlasPageIds { 0 };
+    size_t m_memoryBudget { DefaultMemoryBudget };
+    Stats m_stats;
+
+    // (utf8, pixel size) pairs waiting to be rendered
+    std::deque<std::pair<std::string, UInt32>> m_prewarmQueue;
+    CZTimer m_prewarmTimer;
+
     // [utf8 code point][size] = image
     std::unordered_map<std::string,
         std::unordered_map<UInt32, std::weak_ptr<RImage>>> m_cache;
-    // [icon name][utf8 code point]
+    // [icon name][utf8 code point], either parsed or a mapped binary table
     std::optional<std::unordered_map<std::string, std::string>> m_codepoints;
+    std::unique_ptr<AKCodepointTable> m_codepointTable;
     skia::textlayout::TextStyle m_style;
     skia::textlayout::ParagraphStyle m_paragraphStyle;
     std::unique_ptr<skia::textlayout::ParagraphBuilder> m_builder;
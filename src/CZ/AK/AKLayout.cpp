@@ -1,18 +1,85 @@
 #include <CZ/AK/AKApp.h>
 #include <CZ/AK/AKLayout.h>
+#include <CZ/AK/AKScene.h>
 #include <CZ/AK/AKTarget.h>
 #include <CZ/AK/AKLog.h>
 #include <CZ/AK/Nodes/AKSubScene.h>
 #include <CZ/Core/Events/CZLayoutEvent.h>
 #include <CZ/Core/CZCore.h>
+#include <yoga/event/event.h>
+#include <yoga/node/Node.h>
+#include <cxxabi.h>
+#include <typeinfo>
+#include <cstdlib>
+#include <algorithm>
+#include <future>
 
 using namespace CZ;
 
+static bool s_statsEnabled { false };
+static AKLayout::Stats s_stats;
+static AKLayout::Stats s_lastStats;
+
+// Shadow tree calculated on a worker thread, see AKLayout::EnableAsync()
+struct AsyncJob
+{
+    CZWeak<AKNode> root;
+    YGNodeRef shadowRoot;
+    std::promise<std::chrono::microseconds> promise;
+    std::future<std::chrono::microseconds> done;
+};
+
+static bool s_asyncEnabled { false };
+static std::shared_ptr<AsyncJob> s_asyncJob;
+
+// Roots that couldn't start a calculation because another one was running
+static std::vector<CZWeak<AKNode>> s_asyncDeferred;
+
+// Shadow nodes of layouts destroyed while the worker thread could still be using them
+static std::vector<std::pair<YGNodeRef, YGConfigRef>> s_deadShadows;
+
+// Yoga events published from the worker thread are not counted
+static thread_local bool t_asyncWorker { false };
+
+// Set while AKScene applies the layout, see PrepareSyncCalculate()
+static bool s_applyingTree { false };
+
+// Relayout boundary being resized by calculateBoundary(), its dirtied callback is ignored
+static YGNodeConstRef s_resizedBoundary { nullptr };
+
+static std::chrono::microseconds ElapsedSince(std::chrono::steady_clock::time_point start) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+}
+
+static std::string ClassName(const AKNode &node) noexcept
+{
+    int status { 0 };
+    char *demangled { abi::__cxa_demangle(typeid(node).name(), nullptr, nullptr, &status) };
+    std::string name { status == 0 && demangled ? demangled : typeid(node).name() };
+    std::free(demangled);
+
+    if (name.starts_with("CZ::"))
+        name.erase(0, 4);
+
+    return name;
+}
+
+static void RepaintTargets(AKNode *root) noexcept
+{
+    if (!root || !root->scene())
+        return;
+
+    for (AKTarget *target : root->scene()->targets())
+        target->markDirty();
+}
+
 AKLayout::AKLayout(AKNode &akNode) noexcept : m_node(YGNodeNew()), m_akNode(akNode)
 {
     m_config = YGConfigNew();
     YGConfigSetPointScaleFactor(m_config, 1.f);
     YGNodeSetConfig(m_node, m_config);
+    YGNodeSetContext(m_node, this);
 
     m_anchorNode.setOnDestroyCallback([this](CZObject*){
         // m_anchorNode.reset();
@@ -22,11 +89,37 @@ AKLayout::AKLayout(AKNode &akNode) noexcept : m_node(YGNodeNew()), m_akNode(akNo
     });
 }
 
+AKLayout::~AKLayout()
+{
+    if (m_shadowNode)
+    {
+        if (s_asyncJob)
+        {
+            YGNodeSetContext(m_shadowNode, nullptr);
+            s_deadShadows.emplace_back(m_shadowNode, m_shadowConfig);
+        }
+        else
+        {
+            YGNodeFree(m_shadowNode);
+            YGConfigFree(m_shadowConfig);
+        }
+    }
+
+    if (m_boundaryNode)
+        YGNodeFree(m_boundaryNode);
+
+    YGNodeFree(m_node);
+    YGConfigFree(m_config);
+}
+
 void AKLayout::setDisplay(YGDisplay display) noexcept
 {
     const bool turnedVisible { this->display() == YGDisplayNone && display != YGDisplayNone };
     YGNodeStyleSetDisplay(m_node, display);
 
+    if (m_boundaryNode)
+        syncBoundaryStyle();
+
     if (turnedVisible)
     {
         for (auto &t : m_akNode.m_targets)
@@ -62,33 +155,390 @@ void AKLayout::setAnchorNode(AKNode *anchor) noexcept
 
 void AKLayout::checkIsDirty() noexcept
 {
-    if (YGNodeIsDirty(m_node))
-        m_akNode.addChange(AKNode::CHLayout);
+    if (m_boundaryNode)
+        syncBoundaryStyle();
+
+    if (!YGNodeIsDirty(m_node))
+        return;
+
+    m_akNode.addChange(AKNode::CHLayout);
+
+    if (!s_statsEnabled || s_stats.dirtySources.size() >= MaxDirtySources)
+        return;
+
+    const bool found { std::any_of(s_stats.dirtySources.begin(), s_stats.dirtySources.end(), [this](const DirtySource &source) {
+        return source.node == &m_akNode;
+    })};
+
+    if (!found)
+        s_stats.dirtySources.emplace_back(&m_akNode, ClassName(m_akNode));
+}
+
+void AKLayout::EnableStats(bool enabled) noexcept
+{
+    static bool subscribed { false };
+
+    // Yoga subscribers can't be removed, so it's subscribed only once
+    if (enabled && !subscribed)
+    {
+        subscribed = true;
+
+        facebook::yoga::Event::subscribe([](YGNodeConstRef, facebook::yoga::Event::Type type, facebook::yoga::Event::Data data) {
+            if (!s_statsEnabled || t_asyncWorker || type != facebook::yoga::Event::LayoutPassEnd)
+                return;
+
+            const auto *layout { data.get<facebook::yoga::Event::LayoutPassEnd>().layoutData };
+
+            if (!layout)
+                return;
+
+            s_stats.layouts += layout->layouts;
+            s_stats.measures += layout->measures;
+            s_stats.cachedLayouts += layout->cachedLayouts;
+            s_stats.cachedMeasures += layout->cachedMeasures;
+            s_stats.measureCallbacks += layout->measureCallbacks;
+        });
+    }
+
+    s_statsEnabled = enabled;
+    s_stats = {};
+    s_lastStats = {};
+}
+
+bool AKLayout::StatsEnabled() noexcept
+{
+    return s_statsEnabled;
+}
+
+const AKLayout::Stats &AKLayout::LastStats() noexcept
+{
+    return s_lastStats;
+}
+
+void AKLayout::FinishStats() noexcept
+{
+    if (!s_statsEnabled)
+        return;
+
+    s_lastStats = std::move(s_stats);
+    s_stats = {};
+}
+
+void AKLayout::CalculateLayout(YGNodeRef node, float availableWidth, float availableHeight, YGDirection ownerDirection) noexcept
+{
+    if (!s_statsEnabled)
+    {
+        YGNodeCalculateLayout(node, availableWidth, availableHeight, ownerDirection);
+        return;
+    }
+
+    const auto start { std::chrono::steady_clock::now() };
+    YGNodeCalculateLayout(node, availableWidth, availableHeight, ownerDirection);
+    s_stats.calculateTime += ElapsedSince(start);
+}
+
+void AKLayout::EnableAsync(bool enabled) noexcept
+{
+    s_asyncEnabled = enabled;
+
+    if (!enabled)
+        FinishAsync(true);
+}
+
+bool AKLayout::AsyncEnabled() noexcept
+{
+    return s_asyncEnabled;
+}
+
+void AKLayout::PrepareSyncCalculate(YGNodeRef node) noexcept
+{
+    /* Layout events (e.g. AKScroll constraints) can't wait for the worker thread, they see the previous
+     * layout of nodes synced into the shadow tree, which is also the one being displayed */
+    if (!s_applyingTree)
+        FinishAsync(true);
+
+    // Yoga clears the dirty flags syncShadow() relies on
+    InvalidateShadows(node);
+}
+
+void AKLayout::InvalidateShadows(YGNodeRef node) noexcept
+{
+    /* Ancestors of dirty nodes are always dirty too, so the outdated nodes remain reachable
+     * from the root by syncShadow(), either through dirty or outdated ones */
+    if (!YGNodeIsDirty(node))
+        return;
+
+    if (auto *layout = static_cast<AKLayout*>(YGNodeGetContext(node)))
+        layout->m_shadowOutdated = true;
+
+    for (size_t i = 0; i < YGNodeGetChildCount(node); i++)
+        InvalidateShadows(YGNodeGetChild(node, i));
+}
+
+YGNodeRef AKLayout::syncShadow() noexcept
+{
+    if (!m_shadowNode)
+    {
+        m_shadowConfig = YGConfigNew();
+        m_shadowNode = YGNodeNewWithConfig(m_shadowConfig);
+        YGNodeSetContext(m_shadowNode, this);
+    }
+    else if (!m_shadowOutdated && !YGNodeIsDirty(m_node))
+        return m_shadowNode;
+
+    m_shadowOutdated = false;
+
+    if (YGConfigGetPointScaleFactor(m_shadowConfig) != pointScaleFactor())
+    {
+        YGConfigSetPointScaleFactor(m_shadowConfig, pointScaleFactor());
+        facebook::yoga::resolveRef(m_shadowNode)->markDirtyAndPropagate();
+    }
+
+    // Only marks it dirty if the style differs
+    YGNodeCopyStyle(m_shadowNode, m_node);
+
+    const size_t count { YGNodeGetChildCount(m_node) };
+    bool sameChildren { YGNodeGetChildCount(m_shadowNode) == count };
+    std::vector<YGNodeRef> children;
+    children.reserve(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto *child { static_cast<AKLayout*>(YGNodeGetContext(YGNodeGetChild(m_node, i))) };
+        children.emplace_back(child->syncShadow());
+        sameChildren = sameChildren && YGNodeGetChild(m_shadowNode, i) == children.back();
+    }
+
+    if (!sameChildren)
+    {
+        while (YGNodeGetChildCount(m_shadowNode) > 0)
+            YGNodeRemoveChild(m_shadowNode, YGNodeGetChild(m_shadowNode, 0));
+
+        for (size_t i = 0; i < children.size(); i++)
+        {
+            // Moved from another parent
+            if (YGNodeRef owner = YGNodeGetOwner(children[i]))
+                YGNodeRemoveChild(owner, children[i]);
+
+            YGNodeInsertChild(m_shadowNode, children[i], i);
+        }
+    }
+
+    // Changes made while the shadow tree is being calculated mark it dirty again
+    facebook::yoga::resolveRef(m_node)->setDirty(false);
+    return m_shadowNode;
+}
+
+void AKLayout::calculateAsync() noexcept
+{
+    // The results of the previous calculation are applied along with the rest of the tree
+    if (!FinishAsync(false))
+    {
+        const bool deferred { s_asyncJob->root == &m_akNode ||
+            std::any_of(s_asyncDeferred.begin(), s_asyncDeferred.end(), [this](const CZWeak<AKNode> &root) {
+                return root == &m_akNode;
+            })};
+
+        if (!deferred)
+            s_asyncDeferred.emplace_back(&m_akNode);
+
+        return;
+    }
+
+    if (!YGNodeIsDirty(m_node))
+        return;
+
+    auto job { std::make_shared<AsyncJob>() };
+    job->root.reset(&m_akNode);
+    job->shadowRoot = syncShadow();
+    job->done = job->promise.get_future();
+    s_asyncJob = job;
+
+    AKApp::Get()->runAsync([job] {
+        const auto start { std::chrono::steady_clock::now() };
+        t_asyncWorker = true;
+        YGNodeCalculateLayout(job->shadowRoot, YGUndefined, YGUndefined, YGDirectionInherit);
+        t_asyncWorker = false;
+        job->promise.set_value(ElapsedSince(start));
+    },
+    [job] {
+        // Applied on the next frame
+        RepaintTargets(job->root);
+    });
+}
+
+bool AKLayout::FinishAsync(bool wait) noexcept
+{
+    if (!s_asyncJob)
+        return true;
+
+    if (!wait && s_asyncJob->done.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+
+    const auto job { std::move(s_asyncJob) };
+    const auto duration { job->done.get() };
+
+    if (s_statsEnabled)
+        s_stats.asyncCalculateTime += duration;
+
+    AdoptShadow(job->shadowRoot);
+
+    for (auto &[node, config] : s_deadShadows)
+    {
+        YGNodeFree(node);
+        YGConfigFree(config);
+    }
+
+    s_deadShadows.clear();
+
+    for (auto &root : s_asyncDeferred)
+        RepaintTargets(root);
+
+    s_asyncDeferred.clear();
+    return true;
+}
+
+void AKLayout::AdoptShadow(YGNodeRef shadow) noexcept
+{
+    auto *layout { static_cast<AKLayout*>(YGNodeGetContext(shadow)) };
+
+    // Destroyed meanwhile, or not recalculated (neither are its children)
+    if (!layout || !YGNodeGetHasNewLayout(shadow))
+        return;
+
+    YGNodeSetHasNewLayout(shadow, false);
+
+    // Includes the Yoga cache, so later main thread calculations can reuse it
+    auto *node { facebook::yoga::resolveRef(layout->m_node) };
+    node->setLayout(facebook::yoga::resolveRef(shadow)->getLayout());
+    node->setHasNewLayout(true);
+
+    for (size_t i = 0; i < YGNodeGetChildCount(shadow); i++)
+        AdoptShadow(YGNodeGetChild(shadow, i));
+}
+
+void AKLayout::setRelayoutBoundary(bool enabled) noexcept
+{
+    if (isRelayoutBoundary() == enabled)
+        return;
+
+    const YGNodeRef from { childrenNode() };
+
+    if (enabled)
+    {
+        m_boundaryNode = YGNodeNewWithConfig(m_config);
+        YGNodeSetContext(m_boundaryNode, this);
+
+        /* Changes below the boundary stop at m_boundaryNode, so the ancestors get no new layout
+         * and applyTree() needs to be told to reach it */
+        YGNodeSetDirtiedFunc(m_boundaryNode, [](YGNodeConstRef node) {
+            if (node == s_resizedBoundary)
+                return;
+
+            auto *layout { static_cast<AKLayout*>(YGNodeGetContext(node)) };
+            layout->m_akNode.propagateNeedsApply();
+            layout->m_akNode.addChange(AKNode::CHLayout);
+        });
+
+        syncBoundaryStyle();
+    }
+
+    const YGNodeRef to { enabled ? m_boundaryNode : m_node };
+
+    // Move the children keeping their order
+    std::vector<YGNodeRef> children;
+    children.reserve(YGNodeGetChildCount(from));
+
+    for (size_t i = 0; i < YGNodeGetChildCount(from); i++)
+        children.emplace_back(YGNodeGetChild(from, i));
+
+    YGNodeRemoveAllChildren(from);
+
+    for (size_t i = 0; i < children.size(); i++)
+        YGNodeInsertChild(to, children[i], i);
+
+    if (!enabled)
+    {
+        YGNodeFree(m_boundaryNode);
+        m_boundaryNode = nullptr;
+    }
+
+    m_akNode.addChange(AKNode::CHLayout);
+}
+
+void AKLayout::syncBoundaryStyle() noexcept
+{
+    YGNodeCopyStyle(m_boundaryNode, m_node);
+
+    // The size is instead the one calculated by the parent layout
+    if (!YGFloatIsUndefined(calculatedWidth()))
+        YGNodeStyleSetWidth(m_boundaryNode, calculatedWidth());
+
+    if (!YGFloatIsUndefined(calculatedHeight()))
+        YGNodeStyleSetHeight(m_boundaryNode, calculatedHeight());
+}
+
+bool AKLayout::calculateBoundary() noexcept
+{
+    if (!m_boundaryNode)
+        return false;
+
+    // No-ops if the size didn't change, calculated right below anyway
+    s_resizedBoundary = m_boundaryNode;
+    YGNodeStyleSetWidth(m_boundaryNode, calculatedWidth());
+    YGNodeStyleSetHeight(m_boundaryNode, calculatedHeight());
+    s_resizedBoundary = nullptr;
+
+    if (!YGNodeIsDirty(m_boundaryNode))
+        return false;
+
+    CalculateLayout(m_boundaryNode, YGUndefined, YGUndefined, YGDirectionInherit);
+    return true;
 }
 
 void AKLayout::apply(bool calculate, bool updateRoot) noexcept
 {
+    const auto start { std::chrono::steady_clock::now() };
+    const auto prevCalculateTime { s_stats.calculateTime };
+    const bool wasApplyingTree { s_applyingTree };
+    bool startAsync { false };
+
     if (m_akNode.parent())
     {
         if (calculate)
-            YGNodeCalculateLayout(
+        {
+            PrepareSyncCalculate(m_node);
+            CalculateLayout(
                 m_node,
                 m_akNode.parent()->layout().calculatedWidth(),
                 m_akNode.parent()->layout().calculatedHeight(),
                 YGDirectionInherit);
+        }
 
         applyTree(&m_akNode);
     }
     else
     {
-        if (calculate)
-            YGNodeCalculateLayout(
+        // The first layout is always calculated synchronously so nodes are never displayed without one
+        if (calculate && s_asyncEnabled && !YGFloatIsUndefined(calculatedWidth()))
+        {
+            // Results of the previous calculation, if ready
+            FinishAsync(false);
+            startAsync = true;
+        }
+        else if (calculate)
+        {
+            PrepareSyncCalculate(m_node);
+            CalculateLayout(
                 m_node,
                 YGUndefined,
                 YGUndefined,
                 YGDirectionInherit);
+        }
 
         YGNodeSetHasNewLayout(m_node, false);
+        m_akNode.m_flags.remove(AKNode::DescendantNeedsApply);
+        calculateBoundary();
 
         if (updateRoot)
         {
@@ -97,24 +547,38 @@ void AKLayout::apply(bool calculate, bool updateRoot) noexcept
                 calculatedWidth(), calculatedHeight());
         }
 
+        s_applyingTree = true;
+
         for (AKNode *child : m_akNode.children(true))
             applyTree(child);
+
+        s_applyingTree = wasApplyingTree;
+
+        // Started after applying, so it includes the changes made from layout events
+        if (startAsync)
+            calculateAsync();
     }
+
+    // YGNodeCalculateLayout calls (including relayout boundaries) are counted separately
+    if (s_statsEnabled)
+        s_stats.applyTime += ElapsedSince(start) - (s_stats.calculateTime - prevCalculateTime);
 }
 
 void AKLayout::calculate() noexcept
 {
     if (m_akNode.parent())
     {
-        YGNodeCalculateLayout(
-            m_akNode.parent()->layout().m_node,
+        PrepareSyncCalculate(m_akNode.parent()->layout().childrenNode());
+        CalculateLayout(
+            m_akNode.parent()->layout().childrenNode(),
             m_akNode.parent()->layout().calculatedWidth(),
             m_akNode.parent()->layout().calculatedHeight(),
             YGDirectionInherit);
     }
     else
     {
-        YGNodeCalculateLayout(
+        PrepareSyncCalculate(m_node);
+        CalculateLayout(
             m_node,
             YGUndefined,
             YGUndefined,
@@ -128,12 +592,33 @@ void AKLayout::applyTree(AKNode *node)
         return;
 
     const bool updateScale { node->parent()->m_flags.has(AKNode::ChildrenNeedScaleUpdate) };
-    const bool updateRect { node->parent()->m_flags.has(AKNode::ChildrenNeedPosUpdate) || YGNodeGetHasNewLayout(node->layout().m_node) };
+    const bool updateRect {
+        node->parent()->m_flags.has(AKNode::ChildrenNeedPosUpdate) ||
+        node->m_flags.has(AKNode::RenderOffsetChanged) ||
+        YGNodeGetHasNewLayout(node->layout().m_node) };
+
+    // Relayout boundaries calculate their children layout here, once their own size is known
+    const bool boundaryChanged { node->layout().calculateBoundary() };
 
     if (!updateScale && !updateRect)
+    {
+        // Only the render offset of a descendant or the layout below a boundary changed
+        if (boundaryChanged || node->m_flags.has(AKNode::DescendantNeedsApply))
+        {
+            node->m_flags.remove(AKNode::DescendantNeedsApply);
+
+            for (AKNode *child : node->children(true))
+                applyTree(child);
+        }
+
         return;
+    }
 
     YGNodeSetHasNewLayout(node->layout().m_node, false);
+    node->m_flags.remove(AKNode::RenderOffsetChanged | AKNode::DescendantNeedsApply);
+
+    if (s_statsEnabled)
+        s_stats.appliedNodes++;
 
     CZBitset<CZLayoutChange> changes;
 
@@ -141,8 +626,8 @@ void AKLayout::applyTree(AKNode *node)
     {
         const auto parentWorldPos { node->layout().anchorNode() ? node->layout().anchorNode()->worldRect().topLeft() : node->parent()->worldRect().topLeft() };
         const auto newWorldRect = SkIRect::MakeXYWH(
-            parentWorldPos.x() + SkScalarFloorToInt(node->layout().calculatedLeft()),
-            parentWorldPos.y() + SkScalarFloorToInt(node->layout().calculatedTop()),
+            parentWorldPos.x() + SkScalarFloorToInt(node->layout().calculatedLeft() + node->m_renderOffset.x()),
+            parentWorldPos.y() + SkScalarFloorToInt(node->layout().calculatedTop() + node->m_renderOffset.y()),
             SkScalarRoundToInt(node->layout().calculatedWidth()),
             SkScalarRoundToInt(node->layout().calculatedHeight()));
 
@@ -161,6 +646,16 @@ void AKLayout::applyTree(AKNode *node)
 
         node->m_worldRect = newWorldRect;
 
+        // Only changes relative to the parent matter, e.g. scrolling moves the slot but not its descendants
+        const SkIRect layoutRect { newWorldRect.makeOffset(-parentWorldPos) };
+
+        if (layoutRect != node->m_layoutRect)
+        {
+            const SkIRect prevLayoutRect { node->m_layoutRect };
+            node->m_layoutRect = layoutRect;
+            node->updateContentBounds(prevLayoutRect);
+        }
+
         /* The sceneRect is relative to the current target viewport.
          * If it differs from the previous frame, the scene damages both.
          * worldRect is not used for this because AKSubScene children would be
@@ -208,7 +703,12 @@ void AKLayout::applyTree(AKNode *node)
     }
 
     if (changes.get() != 0)
+    {
+        if (s_statsEnabled)
+            s_stats.layoutEvents++;
+
         CZCore::Get()->sendEvent(CZLayoutEvent(changes), *node);
+    }
 
     for (AKNode *child : node->children(true))
         applyTree(child);
@@ -4,6 +4,9 @@
 #include <CZ/AK/AK.h>
 #include <CZ/Core/CZWeak.h>
 #include <yoga/Yoga.h>
+#include <chrono>
+#include <string>
+#include <vector>
 
 class CZ::AKLayout
 {
@@ -587,23 +590,130 @@ public:
      */
     void calculate(float availableWidth, float availableHeight, YGDirection ownerDirection) noexcept
     {
-        YGNodeCalculateLayout(m_node, availableWidth, availableHeight, ownerDirection);
+        PrepareSyncCalculate(m_node);
+        CalculateLayout(m_node, availableWidth, availableHeight, ownerDirection);
     }
 
     YGNodeRef ygNode() const noexcept { return m_node; };
 
+    /**
+     * @brief Makes the node a relayout boundary.
+     *
+     * The children of a boundary are laid out separately within the size assigned to the node by its
+     * parent, so changes in its subtree never mark the ancestors dirty. During AKScene::render(), only
+     * the subtree below the boundary is recalculated instead of the whole tree from the root.
+     *
+     * The node size must not depend on its children (e.g. a fixed, percentage or flex size),
+     * since they are no longer part of the parent layout. Disabled by default.
+     */
+    void setRelayoutBoundary(bool enabled) noexcept;
+    bool isRelayoutBoundary() const noexcept { return m_boundaryNode != nullptr; }
+
+    /**
+     * @brief A node whose style changes marked the layout dirty.
+     */
+    struct DirtySource
+    {
+        CZWeak<AKNode> node;
+        std::string className;
+    };
+
+    /**
+     * @brief Layout instrumentation, see EnableStats().
+     *
+     * Accumulated from the end of an AKScene layout pass until the end of the next one.
+     */
+    struct Stats
+    {
+        UInt32 layouts { 0 };          ///< Nodes laid out by Yoga
+        UInt32 measures { 0 };         ///< Nodes measured by Yoga
+        UInt32 cachedLayouts { 0 };    ///< Layouts served from the Yoga cache
+        UInt32 cachedMeasures { 0 };   ///< Measures served from the Yoga cache
+        UInt32 measureCallbacks { 0 }; ///< Measure function calls
+        UInt32 appliedNodes { 0 };     ///< Nodes whose rect or scale was updated by AKScene::render()
+        UInt32 layoutEvents { 0 };     ///< CZLayoutEvents sent by AKScene::render()
+        std::chrono::microseconds calculateTime {}; ///< Time spent in YGNodeCalculateLayout
+        std::chrono::microseconds applyTime {};     ///< Time spent updating world rects and sending layout events
+        std::chrono::microseconds asyncCalculateTime {}; ///< Time spent in YGNodeCalculateLayout on a worker thread, see EnableAsync()
+        std::vector<DirtySource> dirtySources;      ///< At most MaxDirtySources, in order
+    };
+
+    static constexpr size_t MaxDirtySources { 64 };
+
+    /**
+     * @brief Enables the layout instrumentation.
+     *
+     * Disabled by default since it adds a small overhead to every style change and layout pass.
+     */
+    static void EnableStats(bool enabled) noexcept;
+    static bool StatsEnabled() noexcept;
+
+    /**
+     * @brief Stats of the last AKScene layout pass.
+     */
+    static const Stats &LastStats() noexcept;
+
+    /**
+     * @brief Calculates the layout of scene roots on a worker thread.
+     *
+     * When enabled, AKScene::render() copies the dirty styles of the tree into a shadow Yoga tree and
+     * calculates it on a worker thread, meanwhile the previous layout remains visible. The results are
+     * applied on the next frame, world rects and CZLayoutEvents are still updated from the main thread.
+     *
+     * Intended for very large trees, e.g. to keep interactive resizing smooth. Explicit calculate() calls
+     * wait for the pending calculation first, except those made from layout events, which see the
+     * previous layout instead. Disabled by default.
+     */
+    static void EnableAsync(bool enabled) noexcept;
+    static bool AsyncEnabled() noexcept;
+
 private:
     friend class AKNode;
     friend class AKScene;
     void apply(bool calculate, bool updateRoot) noexcept;
     AKLayout(AKNode &akNode) noexcept;
     CZ_DISABLE_COPY(AKLayout)
-    ~AKLayout() { YGNodeFree(m_node); YGConfigFree(m_config); }
+    ~AKLayout();
     void checkIsDirty() noexcept;
 
+    // Yoga node the children are inserted into
+    YGNodeRef childrenNode() const noexcept { return m_boundaryNode ? m_boundaryNode : m_node; }
+    void syncBoundaryStyle() noexcept;
+    bool calculateBoundary() noexcept;
+
     // Only called by AKScene, updates worldRect, sceneRect, etc
     static void applyTree(AKNode *node);
+
+    // Instrumented YGNodeCalculateLayout
+    static void CalculateLayout(YGNodeRef node, float availableWidth, float availableHeight, YGDirection ownerDirection) noexcept;
+
+    // Called by AKScene at the end of each layout pass
+    static void FinishStats() noexcept;
+
+    // Copies the dirty styles and children of the subtree into the shadow tree, returns the shadow node
+    YGNodeRef syncShadow() noexcept;
+
+    // Starts calculating the shadow tree on a worker thread if the layout is dirty
+    void calculateAsync() noexcept;
+
+    // Applies the results of the async calculation (if any), returns false if it is still running
+    static bool FinishAsync(bool wait) noexcept;
+    static void AdoptShadow(YGNodeRef shadow) noexcept;
+
+    // Must be called before calculating node (a Yoga tree or subtree) from the main thread
+    static void PrepareSyncCalculate(YGNodeRef node) noexcept;
+    static void InvalidateShadows(YGNodeRef node) noexcept;
     YGNodeRef m_node { nullptr };
+
+    // Root of the children layout if this is a relayout boundary, with the same style but sized by the parent layout
+    YGNodeRef m_boundaryNode { nullptr };
+
+    // Copy of m_node calculated on a worker thread, see EnableAsync()
+    YGNodeRef m_shadowNode { nullptr };
+    YGConfigRef m_shadowConfig { nullptr };
+
+    // Set if calculated from the main thread while dirty, the dirty flag no longer tells if the shadow node is outdated
+    bool m_shadowOutdated { false };
     AKNode &m_akNode;
     YGConfigRef m_config;
 
@@ -157,21 +157,13 @@ bool AKScene::validateTarget(std::shared_ptr<AKTarget> target) noexcept
         return false;
     }
 
-    pass = target->surface->beginPass();
-
-    if (!pass)
-    {
-        AKLog(CZError, CZLN, "Failed to create RPass");
-        return false;
-    }
-
     if (target->age > AK_MAX_BUFFER_AGE || target->m_needsFullRepaint)
         target->age = 0;
 
     return true;
 }
 
-void AKScene::layoutTree() noexcept
+void AKScene::setupTarget() noexcept
 {
     // Round and store the RScene viewport just in case the user unsets it layer
     ct->m_worldViewport = ct->surface->geometry().viewport.round();
@@ -185,16 +177,29 @@ void AKScene::layoutTree() noexcept
     }
     else
         ct->m_clip.setRect(ct->m_sceneViewport);
+}
 
+void AKScene::layoutTree() noexcept
+{
     const bool isNestedScene { root()->parent() != nullptr && isSubScene() };
 
-    if (!isNestedScene)
+    if (isNestedScene)
+        return;
+
+    // A single pass for all targets, the nodes scale already depends on every target viewport
+    bool scaleChanged { false };
+    bool calculate { false };
+
+    for (const auto &target : m_frameTargets)
     {
-        const bool scaleChanged { ct->m_bakedNodesScale != ct->m_prevBakedNodesScale };
-        root()->m_flags.setFlag(AKNode::ChildrenNeedScaleUpdate, scaleChanged);
-        root()->layout().apply(ct->layoutOnRender, true);
-        root()->m_flags.remove(AKNode::ChildrenNeedScaleUpdate);
+        scaleChanged |= target->m_bakedNodesScale != target->m_prevBakedNodesScale;
+        calculate |= target->layoutOnRender;
     }
+
+    root()->m_flags.setFlag(AKNode::ChildrenNeedScaleUpdate, scaleChanged);
+    root()->layout().apply(calculate, true);
+    root()->m_flags.remove(AKNode::ChildrenNeedScaleUpdate);
+    AKLayout::FinishStats();
 }
 
 void AKScene::setupInvisibleRegion() noexcept
@@ -215,29 +220,88 @@ void AKScene::treeNotifyBegin() noexcept
         notifyBegin(*it);
 }
 
-void AKScene::notifyBegin(AKNode *node)
+bool AKScene::skipNode(AKNode *node) const noexcept
 {
-    createOrAssignTargetDataForNode(node);
-
     const bool visible { SkIRect::Intersects(node->worldRect(), ct->m_worldViewport) };
 
     /* We can skip rendering an entire subtree as long as the parent clips its children.
      * If prevSceneClip is not empty it means part of the node was visible in the previous frame, in that case,
      * let the scene handle it one more time to clear that region */
-    if (((!visible && node->childrenClippingEnabled()) || !node->visible()) && node->tData->prevSceneClip.isEmpty())
+    return ((!visible && node->childrenClippingEnabled()) || !node->visible()) && node->tData->prevSceneClip.isEmpty();
+}
+
+void AKScene::notifyBegin(AKNode *node)
+{
+    const auto &front { m_frameTargets.front() };
+    bool skip { true };
+
+    for (const auto &target : m_frameTargets)
     {
-        node->m_flags.add(AKNode::Skip);
-        return;
+        ct = target;
+        createOrAssignTargetDataForNode(node);
+        skip &= skipNode(node);
     }
 
-    node->m_flags.remove(AKNode::Skip);
+    // Skipped only if not visible on any target, treeUpdateSkip() refines it for each one
+    node->m_flags.setFlag(AKNode::Skip, skip);
+
+    if (skip)
+    {
+        ct = front;
+        return;
+    }
 
     // Children of an AKSubScene are notified later by the AKSubScene itself
     if (!node->asSubScene())
         for (auto it = node->children(true).rbegin(); it != node->children(true).rend(); it++)
             notifyBegin(*it);
 
+    /* onSceneBegin() runs once for all targets, changes() must then include the changes of every target
+     * (they only differ if the node was presented to some of them for the first time) */
+    if (m_frameTargets.size() > 1)
+    {
+        AKChanges changes;
+
+        for (const auto &target : m_frameTargets)
+            changes |= node->m_targets[target.get()].changes;
+
+        for (const auto &target : m_frameTargets)
+            node->m_targets[target.get()].changes |= changes;
+    }
+
+    ct = front;
+    node->tData = &node->m_targets[ct.get()];
     node->onSceneBegin();
+
+    // Background effect rects are calculated later in calculateNewDamage()
+    if (!node->asBackgroundEffect())
+        updateIntersectedTargets(node);
+}
+
+void AKScene::treeUpdateSkip() noexcept
+{
+    for (AKNode *child : root()->children(true))
+        updateSkip(child);
+}
+
+void AKScene::updateSkip(AKNode *node) noexcept
+{
+    createOrAssignTargetDataForNode(node);
+    node->m_flags.setFlag(AKNode::Skip, skipNode(node));
+
+    if (node->m_flags.has(AKNode::Skip) || node->asSubScene())
+        return;
+
+    for (AKNode *child : node->children(true))
+        updateSkip(child);
+}
+
+void AKScene::updateIntersectedTargets(AKNode *node) noexcept
+{
+    node->m_intersectedTargets.clear();
+    for (AKTarget *target : targets())
+        if (SkIRect::Intersects(node->worldRect(), target->m_worldViewport))
+            node->m_intersectedTargets.insert(target);
 }
 
 void AKScene::calculateTreeDamage() noexcept
@@ -258,6 +322,11 @@ void AKScene::calculateTreeDamage() noexcept
 }
 
 bool AKScene::render(std::shared_ptr<AKTarget> target) noexcept
+{
+    return render(std::vector<std::shared_ptr<AKTarget>> { target });
+}
+
+bool AKScene::render(const std::vector<std::shared_ptr<AKTarget>> &targets) noexcept
 {
     if (!root())
     {
@@ -265,30 +334,87 @@ bool AKScene::render(std::shared_ptr<AKTarget> target) noexcept
         return false;
     }
 
-    if (!validateTarget(target))
+    bool ok { true };
+    m_frameTargets.clear();
+
+    for (const auto &target : targets)
     {
-        AKLog(CZError, CZLN, "Invalid AKTarget");
-        return false;
+        if (!validateTarget(target))
+        {
+            AKLog(CZError, CZLN, "Invalid AKTarget");
+            ok = false;
+            continue;
+        }
+
+        if (std::find(m_frameTargets.begin(), m_frameTargets.end(), target) == m_frameTargets.end())
+            m_frameTargets.emplace_back(target);
     }
 
-    // Temporarily store the target to prevent passing it around to every function (unset at the end)
-    ct = target;
+    if (m_frameTargets.empty())
+        return false;
+
+    auto app { AKApp::Get() };
+
+    // Sub scenes are rendered in the middle of the parent scene frame
+    if (!isSubScene())
+        app->tickAnimations();
 
-    // AKScene calculates regions and draws relative to the viewport origin
-    auto geometry { pass->geometry() };
-    geometry.viewport.offsetTo(0, 0);
-    pass->setGeometry(geometry);
+    // Temporarily store the target to prevent passing it around to every function (unset at the end)
+    for (const auto &target : m_frameTargets)
+    {
+        ct = target;
+        setupTarget();
+    }
 
+    // Shared by all targets
     layoutTree();
-    setupInvisibleRegion();
     treeNotifyBegin();
-    calculateTreeDamage();
-    updateDamageRing();
-    renderBackground();
-    renderTree();
-    resetTarget();
-    pass.reset();
-    return true;
+
+    for (const auto &target : m_frameTargets)
+    {
+        ct = target;
+        pass = ct->surface->beginPass();
+
+        if (!pass)
+        {
+            AKLog(CZError, CZLN, "Failed to create RPass");
+            ok = false;
+            m_scrollBlits.clear();
+            ct.reset();
+            continue;
+        }
+
+        // AKScene calculates regions and draws relative to the viewport origin
+        auto geometry { pass->geometry() };
+        geometry.viewport.offsetTo(0, 0);
+        pass->setGeometry(geometry);
+
+        // treeNotifyBegin() only skipped the nodes not visible on any target
+        if (m_frameTargets.size() > 1)
+            treeUpdateSkip();
+
+        setupInvisibleRegion();
+        calculateTreeDamage();
+        prepareScrollBlits();
+        updateDamageRing();
+        performScrollBlits();
+        renderBackground();
+        renderTree();
+        resetTarget();
+        pass.reset();
+
+        if (!isSubScene())
+            app->onFrameRendered(target.get());
+    }
+
+    m_frameTargets.clear();
+
+    if (!isSubScene())
+        app->requestAnimationFrames();
+
+    app->onFirstFrame();
+
+    return ok;
 }
 
 void AKScene::createOrAssignTargetDataForNode(AKNode *node) noexcept
@@ -359,11 +485,9 @@ void AKScene::calculateNewDamage(AKNode *node)
         node->tData->visible = node->visible() && parentIsVisible;
     }
 
-    // Update intersected targets
-    node->m_intersectedTargets.clear();
-    for (AKTarget *target : targets())
-        if (SkIRect::Intersects(node->worldRect(), target->m_worldViewport))
-            node->m_intersectedTargets.insert(target);
+    // The intersected targets of other nodes are updated once for all targets in notifyBegin()
+    if (bgFx)
+        updateIntersectedTargets(node);
 
     /// CALCULATE CLIP ///
 
@@ -379,6 +503,8 @@ void AKScene::calculateNewDamage(AKNode *node)
     }
     // Prevent rendering areas covered by opaque overlay nodes
     clip.op(ct->m_opaque, SkRegion::Op::kDifference_Op);
+    // Translates prevSceneClip if the node was shifted along with the pixels of a scroll blit
+    const bool shifted { !m_scrollBlits.empty() && handleScrollBlits(node, clip) };
     // Also subtracted from the previous frame clip to avoid rendering the difference
     node->tData->prevSceneClip.op(ct->m_opaque, SkRegion::Op::kDifference_Op);
 
@@ -482,7 +608,7 @@ void AKScene::calculateNewDamage(AKNode *node)
     else
         goto skipDamage; // Non-renderables do not generate damage
 
-    if (node->m_sceneRect == node->tData->prevSceneRect)
+    if (shifted || node->m_sceneRect == node->tData->prevSceneRect)
     {
         node->tData->prevSceneClip.op(clip, SkRegion::Op::kXOR_Op);
         addNodeDamage(*node, node->tData->prevSceneClip);
@@ -602,6 +728,11 @@ void AKScene::updateDamageRing() noexcept
 
         ct->m_damageRing[ct->m_damageIndex] = ct->m_damage;
 
+        // Pixels moved by scroll blits changed too, even though they are not repainted
+        for (const auto &blit : m_scrollBlits)
+            if (blit.active)
+                ct->m_damageRing[ct->m_damageIndex].op(blit.valid, SkRegion::Op::kUnion_Op);
+
         for (UInt32 i = 1; i < ct->age; i++)
         {
             Int32 damageIndex = ct->m_damageIndex - i;
@@ -620,8 +751,14 @@ void AKScene::updateDamageRing() noexcept
         ct->m_damage.op(*ct->inClip, SkRegion::Op::kIntersect_Op);
 
     if (ct->outDamage)
+    {
         *ct->outDamage = ct->m_damage;
 
+        for (const auto &blit : m_scrollBlits)
+            if (blit.active)
+                ct->outDamage->op(blit.valid, SkRegion::Op::kUnion_Op);
+    }
+
     if (ct->outOpaque)
         *ct->outOpaque = ct->m_opaque;
 
@@ -743,9 +880,229 @@ void AKScene::resetTarget() noexcept
     ct->m_clip.setEmpty();
     ct->m_translucent.setEmpty();
     ct->m_bdts.clear();
+    m_scrollBlits.clear();
     ct.reset();
 }
 
+static bool IsPixelAligned(const std::shared_ptr<RSurface> &surface, SkIPoint delta) noexcept
+{
+    const auto &geo { surface->geometry() };
+
+    if (geo.transform != CZTransform::Normal || geo.viewport.isEmpty())
+        return false;
+
+    const SkScalar scale { geo.dst.width() / geo.viewport.width() };
+    return SkScalarIsInt(delta.x() * scale) && SkScalarIsInt(delta.y() * scale);
+}
+
+void AKScene::addScrollBlit(AKNode *clipper, AKNode *content) noexcept
+{
+    // The buffer must contain exactly the previous frame
+    if (!ct || ct->age != 1 || !clipper || !content || !clipper->tData || !content->tData)
+        return;
+
+    const SkIRect clipperRect { clipper->worldRect().makeOffset(-ct->m_worldViewport.topLeft()) };
+    const SkIRect contentRect { content->worldRect().makeOffset(-ct->m_worldViewport.topLeft()) };
+
+    if (clipperRect != clipper->tData->prevSceneRect || contentRect.size() != content->tData->prevSceneRect.size())
+        return;
+
+    ScrollBlit blit {};
+    blit.clipper = clipper;
+    blit.content = content;
+    blit.delta = contentRect.topLeft() - content->tData->prevSceneRect.topLeft();
+
+    if (blit.delta.isZero() || !IsPixelAligned(ct->surface, blit.delta))
+        return;
+
+    blit.region = clipper->tData->prevSceneClip;
+
+    // Overlapping blits (e.g. nested scrolls) are not combined
+    for (const auto &other : m_scrollBlits)
+        if (other.region.intersects(blit.region))
+            return;
+
+    blit.valid = blit.region;
+    blit.valid.translate(blit.delta.x(), blit.delta.y());
+    blit.valid.op(blit.region, SkRegion::Op::kIntersect_Op);
+    blit.valid.op(ct->m_clip, SkRegion::Op::kIntersect_Op);
+
+    if (blit.valid.isEmpty())
+        return;
+
+    m_scrollBlits.emplace_back(std::move(blit));
+}
+
+bool AKScene::handleScrollBlits(AKNode *node, const SkRegion &clip) noexcept
+{
+    for (auto &blit : m_scrollBlits)
+    {
+        if (!blit.active)
+            continue;
+
+        if (node == blit.clipper)
+        {
+            // Moved, resized or covered differently, the previous pixels can't be reused
+            if (clip != blit.region)
+                blit.active = false;
+
+            continue;
+        }
+
+        if (node == blit.content)
+        {
+            blit.contentVisited = true;
+            continue;
+        }
+
+        const bool inside { node->isSubchildOf(blit.content) };
+
+        if (inside && node->m_sceneRect == node->tData->prevSceneRect.makeOffset(blit.delta.x(), blit.delta.y()))
+        {
+            node->tData->prevSceneClip.translate(blit.delta.x(), blit.delta.y());
+
+            if (node->bdt.enabled())
+                blit.shiftedBdts.emplace_back(&node->bdt);
+
+            return true;
+        }
+
+        /* Nodes above the content (processed before it, excluding ancestors) or inside it but not
+         * shifted: their previous pixels were moved by the blit and must be repainted over */
+        if (node->asRenderable() && (inside || (!blit.contentVisited && !blit.content->isSubchildOf(node))))
+        {
+            SkRegion damage { node->tData->prevSceneClip };
+            damage.translate(blit.delta.x(), blit.delta.y());
+            damage.op(clip, SkRegion::Op::kUnion_Op);
+            damage.op(blit.valid, SkRegion::Op::kIntersect_Op);
+            addNodeDamage(*node, damage);
+        }
+    }
+
+    return false;
+}
+
+void AKScene::prepareScrollBlits() noexcept
+{
+    if (std::none_of(m_scrollBlits.begin(), m_scrollBlits.end(), [](const auto &blit) { return blit.active; }))
+        return;
+
+    if (!ct->m_blitSurface)
+        ct->m_blitSurface = RSurface::Make(ct->m_sceneViewport.size(), 1.f, false);
+
+    for (auto &blit : m_scrollBlits)
+    {
+        if (!blit.active)
+            continue;
+
+        if (!ct->m_blitSurface)
+        {
+            AKLog(CZError, CZLN, "Failed to create the scroll blit surface");
+            addNodeDamage(*blit.clipper, blit.region);
+            blit.active = false;
+            continue;
+        }
+
+        // Newly exposed strip
+        SkRegion exposed { blit.region };
+        exposed.op(blit.valid, SkRegion::Op::kDifference_Op);
+        addNodeDamage(*blit.clipper, exposed);
+
+        // Captured backgrounds are shifted too if their node was, otherwise repainted
+        for (auto &bdt : ct->m_bdts)
+        {
+            SkRegion captured { blit.valid };
+
+            if (!captured.op(bdt->captureRectTranslated(), SkRegion::Op::kIntersect_Op))
+                continue;
+
+            const bool shifted { std::find(blit.shiftedBdts.begin(), blit.shiftedBdts.end(), bdt.get()) != blit.shiftedBdts.end() };
+            auto surface { bdt->m_surfaces[ct.get()] };
+
+            if (shifted && surface && IsPixelAligned(surface, blit.delta))
+                blit.bdts.emplace_back(bdt.get(), std::move(captured));
+            else
+                addNodeDamage(bdt->node(), captured);
+        }
+    }
+}
+
+void AKScene::performScrollBlits() noexcept
+{
+    for (auto &blit : m_scrollBlits)
+    {
+        if (!blit.active)
+            continue;
+
+        // Damaged areas are repainted anyway
+        SkRegion region { blit.valid };
+        region.op(ct->m_damage, SkRegion::Op::kDifference_Op);
+
+        if (!region.isEmpty() && !blitSurface(ct->surface, pass, region, blit.delta))
+            addNodeDamage(*blit.clipper, region);
+
+        for (auto &[bdt, captured] : blit.bdts)
+        {
+            if (!captured.op(ct->m_damage, SkRegion::Op::kDifference_Op))
+                continue;
+
+            auto surface { bdt->m_surfaces[ct.get()] };
+
+            if (!blitSurface(surface, surface->beginPass(RPassCap_Painter), captured, blit.delta))
+                addNodeDamage(bdt->node(), captured);
+        }
+    }
+}
+
+bool AKScene::blitSurface(std::shared_ptr<RSurface> surface, std::shared_ptr<RPass> dstPass, const SkRegion &region, SkIPoint delta) noexcept
+{
+    if (!surface || !dstPass)
+        return false;
+
+    // The source can't be sampled while drawing into it, so it is copied into the scratch surface first
+    auto geo { surface->geometry() };
+    geo.viewport.offsetTo(0.f, 0.f);
+    const SkIRect viewport { geo.viewport.roundOut() };
+    ct->m_blitSurface->resize(viewport.size(), geo.dst.width() / geo.viewport.width(), true);
+    auto scratchGeo { ct->m_blitSurface->geometry() };
+    scratchGeo.viewport.offsetTo(0.f, 0.f);
+    ct->m_blitSurface->setGeometry(scratchGeo);
+
+    auto scratchPass { ct->m_blitSurface->beginPass(RPassCap_Painter) };
+
+    if (!scratchPass)
+    {
+        AKLog(CZError, CZLN, "Failed to create RPass");
+        return false;
+    }
+
+    SkRegion src;
+    region.translate(-delta.x(), -delta.y(), &src);
+
+    RDrawImageInfo info {};
+    info.image = surface->image();
+    info.src = geo.dst;
+    info.srcTransform = geo.transform;
+    info.dst = viewport;
+
+    auto *painter { scratchPass->getPainter() };
+    painter->setBlendMode(RBlendMode::Src);
+    painter->drawImage(info, &src);
+    scratchPass.reset();
+
+    info.image = ct->m_blitSurface->image();
+    info.src = ct->m_blitSurface->geometry().dst;
+    info.srcTransform = CZTransform::Normal;
+    info.dst = viewport.makeOffset(delta.x(), delta.y());
+
+    dstPass->save();
+    painter = dstPass->getPainter();
+    painter->setBlendMode(RBlendMode::Src);
+    painter->drawImage(info, &region);
+    dstPass->restore();
+    return true;
+}
+
 void AKScene::backgroundPass(std::shared_ptr<RPass> pass, SkRegion &region) noexcept
 {
     pass->save();
@@ -21,7 +21,18 @@ public:
 
     bool render(std::shared_ptr<AKTarget> target) noexcept;
 
-    // Target passed to render(), set to nullptr after the call finishes
+    /**
+     * @brief Renders the scene into multiple targets at once.
+     *
+     * Intended for targets displaying the same scene (e.g. multiple or mirrored outputs).
+     * The layout and AKNode::onSceneBegin() run once for all targets, only the damage
+     * calculation and drawing are performed for each one, in the given order.
+     *
+     * @return true if all targets were rendered, false if any of them is invalid.
+     */
+    bool render(const std::vector<std::shared_ptr<AKTarget>> &targets) noexcept;
+
+    // Target being rendered by render(), set to nullptr after the call finishes
     std::shared_ptr<AKTarget> currentTarget() const noexcept { return ct; }
 
     /**
@@ -48,20 +59,47 @@ private:
     friend class AKTarget;
     friend class AKNode;
     friend class AKSubScene;
+    friend class AKScroll;
     friend class MSurface;
     static std::shared_ptr<AKScene> MakeSubScene() noexcept;
     AKScene(bool isSubScene) noexcept;
     bool validateTarget(std::shared_ptr<AKTarget> target) noexcept;
+    void setupTarget() noexcept;
     void layoutTree() noexcept;
     void setupInvisibleRegion() noexcept;
     void treeNotifyBegin() noexcept;
     void notifyBegin(AKNode *node);
+    bool skipNode(AKNode *node) const noexcept;
+    void treeUpdateSkip() noexcept;
+    void updateSkip(AKNode *node) noexcept;
+    void updateIntersectedTargets(AKNode *node) noexcept;
     void calculateTreeDamage() noexcept;
     void renderBackground() noexcept;
+
+    // Pixels of a clipped area reused by shifting them instead of repainting (see AKScroll::setScrollBlitEnabled())
+    struct ScrollBlit
+    {
+        AKNode *clipper;
+        AKNode *content;
+        SkIPoint delta;
+        SkRegion region; // Visible region of the clipper in the previous frame
+        SkRegion valid; // Part of region whose pixels are still valid after shifting them by delta
+        std::vector<std::pair<AKBackgroundDamageTracker*, SkRegion>> bdts; // Captures shifted along
+        std::vector<AKBackgroundDamageTracker*> shiftedBdts;
+        bool contentVisited { false };
+        bool active { true };
+    };
+    std::vector<ScrollBlit> m_scrollBlits;
+    void addScrollBlit(AKNode *clipper, AKNode *content) noexcept;
+    bool handleScrollBlits(AKNode *node, const SkRegion &clip) noexcept;
+    void prepareScrollBlits() noexcept;
+    void performScrollBlits() noexcept;
+    bool blitSurface(std::shared_ptr<RSurface> surface, std::shared_ptr<RPass> dstPass, const SkRegion &region, SkIPoint delta) noexcept;
     void renderTree() noexcept;
     void resetTarget() noexcept;
     std::weak_ptr<AKScene> m_self;
     std::shared_ptr<AKTarget> ct;
+    std::vector<std::shared_ptr<AKTarget>> m_frameTargets; // Targets of the current render() call
     std::shared_ptr<RPass> pass;
     std::vector<AKTarget*> m_targets;
     CZWeak<AKNode> m_root;
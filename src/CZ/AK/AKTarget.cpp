@@ -1,6 +1,7 @@
 #include <CZ/AK/AKTarget.h>
 #include <CZ/AK/Nodes/AKNode.h>
 #include <CZ/AK/AKScene.h>
+#include <CZ/AK/AKApp.h>
 #include <CZ/Core/Utils/CZVectorUtils.h>
 
 using namespace CZ;
@@ -31,6 +32,37 @@ void AKTarget::markDirty() noexcept
 
     m_isDirty = true;
     onMarkedDirty.notify(*this);
+
+    if (!m_scene->isSubScene())
+        if (auto app = AKApp::Get())
+            app->scheduleFrame(this);
+}
+
+void AKTarget::frameDone(std::chrono::steady_clock::time_point presentationTime) noexcept
+{
+    m_lastFrameTime = presentationTime;
+    m_waitingFrameDone = false;
+
+    if (m_isDirty && !m_scene->isSubScene())
+        if (auto app = AKApp::Get())
+            app->scheduleFrame(this);
+}
+
+void AKTarget::setFrameFeedbackEnabled(bool enabled) noexcept
+{
+    if (m_frameFeedback == enabled)
+        return;
+
+    m_frameFeedback = enabled;
+
+    if (!enabled)
+    {
+        m_waitingFrameDone = false;
+
+        if (m_isDirty && !m_scene->isSubScene())
+            if (auto app = AKApp::Get())
+                app->scheduleFrame(this);
+    }
 }
 
 AKTarget::AKTarget(std::shared_ptr<AKScene> scene) noexcept : m_scene(scene)
@@ -41,5 +73,9 @@ AKTarget::AKTarget(std::shared_ptr<AKScene> scene) noexcept : m_scene(scene)
 AKTarget::~AKTarget() noexcept
 {
     CZVectorUtils::RemoveOneUnordered(m_scene->m_targets, this);
+
+    if (auto app = AKApp::Get())
+        std::erase(app->m_frameQueue, this);
+
     notifyDestruction();
 }
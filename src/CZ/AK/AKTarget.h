@@ -11,6 +11,7 @@
 #include <CZ/skia/core/SkMatrix.h>
 #include <CZ/skia/core/SkRegion.h>
 #include <yoga/Yoga.h>
+#include <chrono>
 
 /**
  * @brief A scene render destination.
@@ -138,7 +139,38 @@ public:
      * meaning this signal is only triggered by nodes that have been rendered at least once by a scene.
      */
     CZSignal<AKTarget&> onMarkedDirty;
+
+    /**
+     * @brief Coalesced frame request signal.
+     *
+     * Unlike onMarkedDirty, which is emitted on each markDirty() call, this signal is emitted by the
+     * AKApp frame scheduler at most once per frame: after the target is marked dirty, once the
+     * AKApp::maxFps() interval since the previous frame elapsed and, if frame feedback is enabled,
+     * after frameDone() was called for the previous frame. Embedders can render the target from here
+     * instead of debouncing onMarkedDirty themselves.
+     *
+     * Not emitted for AKSubScene targets.
+     */
+    CZSignal<AKTarget&> onFrameRequest;
+
+    /**
+     * @brief Reports that the last rendered frame was presented.
+     *
+     * Should be called on the vblank, frame callback or presentation feedback event of the surface.
+     *
+     * @param presentationTime When the frame was presented, the next frame is scheduled relative to it.
+     */
+    void frameDone(std::chrono::steady_clock::time_point presentationTime = std::chrono::steady_clock::now()) noexcept;
+
+    /**
+     * @brief Waits for frameDone() before requesting the next frame.
+     *
+     * Disabled by default, in which case frame requests are only throttled by AKApp::maxFps().
+     */
+    void setFrameFeedbackEnabled(bool enabled) noexcept;
+    bool frameFeedbackEnabled() const noexcept { return m_frameFeedback; }
 private:
+    friend class AKApp;
     friend class AKScene;
     friend class AKNode;
     friend class AKSubScene;
@@ -164,9 +196,18 @@ private:
     bool                m_isDirty { false };
     bool                m_needsFullRepaint { true };
 
+    // Frame scheduling, see AKApp::scheduleFrame()
+    std::chrono::steady_clock::time_point m_lastFrameTime {};
+    bool                m_frameRequested { false }; // onFrameRequest emitted, not rendered yet
+    bool                m_waitingFrameDone { false };
+    bool                m_frameFeedback { false };
+
     std::vector<CZWeak<AKBackgroundDamageTracker>>    m_bdts;
     std::vector<CZWeak<AKBackgroundDamageTracker>>    m_bdtsPrev;
     std::vector<SkIRect>            m_bdtPrevRectsTranslated;
+
+    // Scratch copy used by scroll blits
+    std::shared_ptr<RSurface> m_blitSurface;
     SkColor             m_clearColor { SK_ColorTRANSPARENT };
 };
 
@@ -0,0 +1,208 @@
+#include <CZ/AK/AKTextBuffer.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace CZ;
+
+static constexpr size_t MinGap { 64 };
+
+static bool isUTF8Continuation(char c) noexcept
+{
+    return (c & 0xC0) == 0x80;
+}
+
+AKTextBuffer::AKTextBuffer(std::string_view utf8) noexcept
+{
+    assign(utf8);
+}
+
+void AKTextBuffer::assign(std::string_view utf8) noexcept
+{
+    m_data.clear();
+    m_offsets.clear();
+    m_gapStart = m_gapEnd = 0;
+    m_offGapStart = m_offGapEnd = 0;
+    insert(0, utf8);
+}
+
+size_t AKTextBuffer::insert(size_t codePoint, std::string_view utf8) noexcept
+{
+    if (utf8.empty())
+        return 0;
+
+    moveGap(std::min(codePoint, codePointCount()));
+    reserveGap(utf8.size());
+
+    const size_t prevGapStart { m_offGapStart };
+
+    for (size_t i = 0; i < utf8.size(); i++)
+    {
+        m_data[m_gapStart + i] = utf8[i];
+
+        if (!isUTF8Continuation(utf8[i]))
+            m_offsets[m_offGapStart++] = m_gapStart + i;
+    }
+
+    m_gapStart += utf8.size();
+    return m_offGapStart - prevGapStart;
+}
+
+size_t AKTextBuffer::erase(size_t codePoint, size_t count) noexcept
+{
+    const size_t total { codePointCount() };
+
+    if (codePoint >= total || count == 0)
+        return 0;
+
+    count = std::min(count, total - codePoint);
+    moveGap(codePoint);
+    m_gapEnd += byteOffset(codePoint + count) - m_gapStart;
+    m_offGapEnd += count;
+    return count;
+}
+
+size_t AKTextBuffer::byteOffset(size_t codePoint) const noexcept
+{
+    if (codePoint >= codePointCount())
+        return size();
+
+    if (codePoint < m_offGapStart)
+        return m_offsets[codePoint];
+
+    return size() - m_offsets[codePoint + m_offGapEnd - m_offGapStart];
+}
+
+size_t AKTextBuffer::codePointIndex(size_t byte) const noexcept
+{
+    // Offsets are sorted on both sides of the gap
+    size_t lo { 0 }, hi { codePointCount() };
+
+    while (lo < hi)
+    {
+        const size_t mid { lo + (hi - lo) / 2 };
+
+        if (byteOffset(mid) < byte)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+std::string_view AKTextBuffer::view() noexcept
+{
+    moveGap(codePointCount());
+    return { m_data.data(), m_gapStart };
+}
+
+std::pair<std::string_view, std::string_view> AKTextBuffer::segments(size_t begin, size_t end) const noexcept
+{
+    end = std::min(end, size());
+    begin = std::min(begin, end);
+
+    const size_t gapSize { m_gapEnd - m_gapStart };
+
+    if (end <= m_gapStart)
+        return { { m_data.data() + begin, end - begin }, {} };
+
+    if (begin >= m_gapStart)
+        return { { m_data.data() + begin + gapSize, end - begin }, {} };
+
+    return { { m_data.data() + begin, m_gapStart - begin }, { m_data.data() + m_gapEnd, end - m_gapStart } };
+}
+
+size_t AKTextBuffer::hash(size_t begin, size_t end) const noexcept
+{
+    // FNV-1a, so that both segments can be hashed as if they were contiguous
+    UInt64 hash { 14695981039346656037ULL };
+    const auto [a, b] { segments(begin, end) };
+
+    for (const auto segment : { a, b })
+        for (const char c : segment)
+        {
+            hash ^= UInt8(c);
+            hash *= 1099511628211ULL;
+        }
+
+    return size_t(hash);
+}
+
+std::string AKTextBuffer::str() const noexcept
+{
+    std::string out;
+    out.reserve(size());
+    out.append(m_data.data(), m_gapStart);
+    out.append(m_data.data() + m_gapEnd, m_data.size() - m_gapEnd);
+    return out;
+}
+
+void AKTextBuffer::copyByteOffsets(std::vector<size_t> &dst) const noexcept
+{
+    const size_t total { size() };
+    dst.resize(codePointCount());
+    std::copy(m_offsets.begin(), m_offsets.begin() + m_offGapStart, dst.begin());
+
+    for (size_t i = m_offGapStart; i < dst.size(); i++)
+        dst[i] = total - m_offsets[i + m_offGapEnd - m_offGapStart];
+}
+
+void AKTextBuffer::moveGap(size_t codePoint) noexcept
+{
+    const size_t total { size() };
+
+    if (codePoint < m_offGapStart)
+    {
+        // Move [codePoint, gap) after the gap
+        const size_t n { m_offGapStart - codePoint };
+        const size_t len { m_gapStart - m_offsets[codePoint] };
+        std::memmove(&m_data[m_gapEnd - len], &m_data[m_gapStart - len], len);
+        m_gapStart -= len;
+        m_gapEnd -= len;
+
+        // Backwards since the destination is after the source
+        for (size_t i = n; i-- > 0;)
+            m_offsets[m_offGapEnd - n + i] = total - m_offsets[codePoint + i];
+
+        m_offGapStart -= n;
+        m_offGapEnd -= n;
+    }
+    else if (codePoint > m_offGapStart)
+    {
+        // Move [gap, codePoint) before the gap
+        const size_t n { codePoint - m_offGapStart };
+        const size_t len { byteOffset(codePoint) - m_gapStart };
+        std::memmove(&m_data[m_gapStart], &m_data[m_gapEnd], len);
+        m_gapStart += len;
+        m_gapEnd += len;
+
+        for (size_t i = 0; i < n; i++)
+            m_offsets[m_offGapStart + i] = total - m_offsets[m_offGapEnd + i];
+
+        m_offGapStart += n;
+        m_offGapEnd += n;
+    }
+}
+
+void AKTextBuffer::reserveGap(size_t bytes) noexcept
+{
+    // A code point takes at least one byte, so the offsets gap never needs more entries than bytes
+
+    if (m_gapEnd - m_gapStart < bytes)
+    {
+        const size_t tail { m_data.size() - m_gapEnd };
+        const size_t newSize { std::max(m_data.size() * 2, size() + bytes + MinGap) };
+        m_data.resize(newSize);
+        std::memmove(&m_data[newSize - tail], &m_data[m_gapEnd], tail);
+        m_gapEnd = newSize - tail;
+    }
+
+    if (m_offGapEnd - m_offGapStart < bytes)
+    {
+        const size_t tail { m_offsets.size() - m_offGapEnd };
+        const size_t newSize { std::max(m_offsets.size() * 2, codePointCount() + bytes + MinGap) };
+        m_offsets.resize(newSize);
+        std::copy_backward(m_offsets.begin() + m_offGapEnd, m_offsets.begin() + m_offGapEnd + tail, m_offsets.end());
+        m_offGapEnd = newSize - tail;
+    }
+}
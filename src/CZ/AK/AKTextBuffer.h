@@ -0,0 +1,105 @@
+#ifndef CZ_AKTEXTBUFFER_H
+#define CZ_AKTEXTBUFFER_H
+
+#include <CZ/AK/AK.h>
+#include <string_view>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief UTF-8 gap buffer.
+ *
+ * Stores UTF-8 text along with the byte offset of each code point. Both share a gap located at the
+ * last edit position, so consecutive insertions/deletions (e.g. typing) only touch the edited bytes.
+ *
+ * Offsets after the gap are stored as distances from the end of the text, this way they remain valid
+ * when bytes are inserted or removed at the gap.
+ */
+class CZ::AKTextBuffer
+{
+public:
+    AKTextBuffer(std::string_view utf8 = {}) noexcept;
+
+    /**
+     * @brief Replaces the entire content.
+     */
+    void assign(std::string_view utf8) noexcept;
+
+    /**
+     * @brief Inserts UTF-8 text before the given code point.
+     *
+     * @return The number of inserted code points.
+     */
+    size_t insert(size_t codePoint, std::string_view utf8) noexcept;
+
+    /**
+     * @brief Removes code points.
+     *
+     * @return The number of removed code points.
+     */
+    size_t erase(size_t codePoint, size_t count) noexcept;
+
+    /**
+     * @brief Size in bytes.
+     */
+    size_t size() const noexcept { return m_data.size() - (m_gapEnd - m_gapStart); }
+    bool empty() const noexcept { return size() == 0; }
+    size_t codePointCount() const noexcept { return m_offsets.size() - (m_offGapEnd - m_offGapStart); }
+
+    /**
+     * @brief Byte offset of a code point.
+     *
+     * @return The byte offset or size() if codePoint >= codePointCount().
+     */
+    size_t byteOffset(size_t codePoint) const noexcept;
+
+    /**
+     * @brief Index of the code point starting at a byte offset.
+     *
+     * If the byte is a continuation byte, the next code point is returned. O(log n).
+     */
+    size_t codePointIndex(size_t byte) const noexcept;
+
+    /**
+     * @brief Views of a byte range, split at the gap.
+     *
+     * The second view is empty unless the range spans the gap. Unlike view(), the gap is not moved.
+     * The views are invalidated by any modification.
+     */
+    std::pair<std::string_view, std::string_view> segments(size_t begin, size_t end) const noexcept;
+
+    /**
+     * @brief Hash of a byte range, independent of the gap position.
+     */
+    size_t hash(size_t begin, size_t end) const noexcept;
+
+    /**
+     * @brief Contiguous view of the text.
+     *
+     * Moves the gap to the end, which is cheap if the last edit was near the end.
+     * The view is invalidated by any modification.
+     */
+    std::string_view view() noexcept;
+
+    /**
+     * @brief Copies the text into a string.
+     */
+    std::string str() const noexcept;
+
+    /**
+     * @brief Copies the byte offset of each code point into a vector.
+     */
+    void copyByteOffsets(std::vector<size_t> &dst) const noexcept;
+private:
+    void moveGap(size_t codePoint) noexcept;
+    void reserveGap(size_t bytes) noexcept;
+    std::string m_data;
+    std::vector<size_t> m_offsets;
+
+    // Gap range in bytes (m_data) and code points (m_offsets)
+    size_t m_gapStart { 0 }, m_gapEnd { 0 };
+    size_t m_offGapStart { 0 }, m_offGapEnd { 0 };
+};
+
+#endif // CZ_AKTEXTBUFFER_H
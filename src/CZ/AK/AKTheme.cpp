@@ -27,14 +27,6 @@ using namespace material_color_utilities;
 
 CZ::AKTheme::AKTheme() noexcept : m_colorTheme(AKColorTheme::MakeFromColor(0xFF3498DB))
 {
-    DefaultFont.setTypeface(
-        AKApp::Get()->fontManager()->matchFamilyStyle("Inter",
-        SkFontStyle(
-        SkFontStyle::kNormal_Weight,
-        SkFontStyle::Width::kNormal_Width,
-        SkFontStyle::Slant::kUpright_Slant)));
-    DefaultFont.setSize(12);
-
     SkPaint defaultTextStylePaint;
     defaultTextStylePaint.setColor(SK_ColorBLACK);
     defaultTextStylePaint.setAntiAlias(true);
@@ -52,183 +44,132 @@ CZ::AKTheme::AKTheme() noexcept : m_colorTheme(AKColorTheme::MakeFromColor(0xFF3
             SkFontStyle::Weight::kSemiBold_Weight,
             SkFontStyle::Width::kNormal_Width,
             SkFontStyle::Slant::kUpright_Slant));
+}
 
-    iconFont = AKIconFont::Make("Material Icons Round", AKFontsDir() / "MaterialIconsRound-Regular.codepoints");
-
-    RRect9Patch.setFactory([](Int32 radius, Int32 scale, SkColor backgroundColor, Int32 strokeWidth, SkColor strokeColor) -> std::shared_ptr<AKAsset::RRect9Patch>
-    {
-        if (radius <= 0) radius = 1;
-        if (scale <= 0) scale = 1;
-        if (strokeWidth < 0 || SkColorGetA(strokeColor) == 0) strokeWidth = 0;
-
-        const auto rad { std::max(radius, strokeWidth) };
-
-        const SkIRect center { SkIRect::MakeXYWH(rad, rad, 1, 1) };
-        const auto size { SkISize(rad * 2 + 1, rad * 2 + 1) };
-        const auto pixelSize { SkISize(size.fWidth * scale, size.fHeight * scale) };
-        auto ream { RCore::Get() };
-        auto *mainDevice { ream->mainDevice() };
-        const auto fmt { mainDevice->textureFormats().formats().find(DRM_FORMAT_ARGB8888) };
-        assert(fmt != mainDevice->textureFormats().formats().end());
-
-        // Use raster for pixel perfect drawing
-
-        SkImageInfo info
-        {
-            SkImageInfo::Make(
-            pixelSize,
-            RSKFormat::FromDRM(fmt->format()),
-            kPremul_SkAlphaType)
-        };
-
-        SkBitmap bitmap;
-
-        if (!bitmap.tryAllocPixels(info))
-        {
-            AKLog(CZDebug, CZLN, "Failed to allocate SkBitmap pixels");
-            return {};
-        }
-
-        SkCanvas c { bitmap };
-        c.clear(SK_ColorTRANSPARENT);
-        c.scale(scale, scale);
-
-        SkPaint paint;
-        paint.setAntiAlias(true);
-        paint.setBlendMode(SkBlendMode::kSrc);
-
-        const auto rect { SkRect::Make(size) };
-
-        if (SkColorGetA(backgroundColor) > 0)
-        {
-            paint.setStroke(false);
-            paint.setColor(backgroundColor);
-            c.drawRoundRect(rect, radius, radius, paint);
-        }
-
-        if (strokeWidth > 0)
-        {
-            paint.setStroke(true);
-            paint.setColor(strokeColor);
-            paint.setStrokeWidth(strokeWidth);
-            const SkScalar inset { SkScalar(strokeWidth) * 0.5f };
-            const auto sRad { std::max(0.f, radius - inset) };
-            c.drawRoundRect(rect.makeInset(inset, inset), sRad, sRad, paint);
-        }
-
-        RPixelBufferInfo pixInfo {};
-        pixInfo.pixels = (UInt8*)bitmap.pixelRef()->pixels();
-        pixInfo.stride = bitmap.pixelRef()->rowBytes();
-        pixInfo.format = DRM_FORMAT_ARGB8888;
-        pixInfo.size = pixelSize;
+const SkFont &CZ::AKTheme::DefaultFont() noexcept
+{
+    // Shared by all themes
+    static SkFont font;
+    static bool loaded { false };
+
+    if (loaded)
+        return font;
+
+    loaded = true;
+    font.setSize(12);
+    auto app { AKApp::Get() };
+    auto fontManager { app->fontManager() };
+    const auto start { std::chrono::steady_clock::now() };
+    font.setTypeface(
+        fontManager->matchFamilyStyle("Inter",
+        SkFontStyle(
+        SkFontStyle::kNormal_Weight,
+        SkFontStyle::Width::kNormal_Width,
+        SkFontStyle::Slant::kUpright_Slant)));
+    app->addStartupStep("AKTheme default typeface",
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+    return font;
+}
 
-        RImageConstraints cons {};
-        cons.allocator = mainDevice;
-        cons.caps[mainDevice] = RImageCap_Src;
+std::shared_ptr<AKIconFont> CZ::AKTheme::iconFont() noexcept
+{
+    if (m_iconFontLoaded)
+        return m_iconFont;
 
-        return std::make_shared<AKAsset::RRect9Patch>(RImage::MakeFromPixels(pixInfo, *fmt, &cons), center);
-    });
+    m_iconFontLoaded = true;
+    auto app { AKApp::Get() };
+    app->fontCollection();
+    const auto start { std::chrono::steady_clock::now() };
 
-    FirstQuadrantCircleMask.setFactory([](Int32 radius, Int32 scale) -> std::shared_ptr<RImage>
-    {
-        if (radius <= 0) radius = 1;
-        if (scale <= 0) scale = 1;
+    // Binary table generated at build time, the text file is used as fallback
+    const auto table { AKFontsDir() / "MaterialIconsRound-Regular.codepoints.bin" };
+    std::error_code ec;
 
-        AKLog.setLevel(CZTrace);
-        AKLog(CZFatal, "First quadrant {} {}", radius, scale);
+    if (std::filesystem::exists(table, ec))
+        m_iconFont = AKIconFont::Make("Material Icons Round", table);
+    else
+        m_iconFont = AKIconFont::Make("Material Icons Round", AKFontsDir() / "MaterialIconsRound-Regular.codepoints");
 
-        auto surface = RSurface::Make(SkISize(radius, radius), scale, true);
-        auto pass { surface->beginPass(RPassCap_SkCanvas) };
-        auto &c { *pass->getCanvas() };
-        c.clear(SK_ColorTRANSPARENT);
+    app->addStartupStep("AKTheme icon font",
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+    return m_iconFont;
+}
 
-        SkPaint paint;
-        paint.setStroke(false);
-        paint.setAntiAlias(true);
-        paint.setColor(SK_ColorWHITE);
-        paint.setBlendMode(SkBlendMode::kSrc);
-        c.drawCircle(SkPoint::Make(radius, radius), radius, paint);
-        return surface->image();
-    });
+void CZ::AKTheme::setIconFont(std::shared_ptr<AKIconFont> iconFont) noexcept
+{
+    m_iconFontLoaded = true;
+    m_iconFont = iconFont;
 }
 
 std::shared_ptr<RImage> CZ::AKTheme::textFieldRoundHThreePatchImage(Int32 scale) noexcept
 {
-    const auto it { m_textFieldRoundHThreePatchImage.find(scale) };
+    const SkISize size(
+        TextFieldRoundHThreePatchSideSrcRect.width() + TextFieldRoundHThreePatchCenterSrcRect.width(),
+        TextFieldRoundHThreePatchSideSrcRect.height());
 
-    if (it != m_textFieldRoundHThreePatchImage.end())
-        return it->second;
+    const auto key { AKAssetCache::MakeKey(AKAssetCache::Kind::TextFieldPatch, size.width(), size.height(), scale) };
 
-    auto surface = RSurface::Make(SkISize(TextFieldRoundHThreePatchSideSrcRect.width() + TextFieldRoundHThreePatchCenterSrcRect.width(),
-                                          TextFieldRoundHThreePatchSideSrcRect.height()),
-                                   scale, true);
+    if (auto image = m_assetCache.get<RImage>(key))
+        return image;
 
-    auto pass { surface->beginPass(RPassCap_SkCanvas) };
-    auto &c { *pass->getCanvas() };
+    auto image { makeRasterImage(key, size, scale, [size](SkCanvas &c) {
+        SkPaint paint;
+        const float borderRadius { 5.f };
+        SkRect roundRect { SkRect::MakeWH(size.width() * 2, size.height()) };
 
-    // c.scale(surface->scale(), surface->scale());
-    c.clear(SK_ColorTRANSPARENT);
+        // Shadow
+        paint.setAntiAlias(true);
+        roundRect.inset(2.5f, 2.5f);
+        roundRect.offset(0.f, 0.5f);
+        paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setColor(SkColorSetARGB(82, 0, 0, 0));
+        paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 1.f));
+        c.drawRoundRect(roundRect, borderRadius, borderRadius, paint);
+        paint.setMaskFilter(nullptr);
+        roundRect.offset(0.f, -0.5f);
+
+        // Border
+        paint.setBlendMode(SkBlendMode::kSrcOver);
+        paint.setStroke(true);
+        paint.setStrokeWidth(1.f);
+        paint.setColor(SkColorSetARGB(9, 0, 0, 0));
+        c.drawRoundRect(roundRect, borderRadius, borderRadius, paint);
+
+        // Fill
+        paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setStroke(false);
+        paint.setColor(SK_ColorWHITE);
+        c.drawRoundRect(roundRect, borderRadius, borderRadius, paint);
+    })};
 
-    SkPaint paint;
-    const float borderRadius { 5.f };
-    SkRect roundRect { SkRect::MakeWH(surface->geometry().viewport.width() * 2, surface->geometry().viewport.height()) };
-
-    // Shadow
-    paint.setAntiAlias(true);
-    roundRect.inset(2.5f, 2.5f);
-    roundRect.offset(0.f, 0.5f);
-    paint.setBlendMode(SkBlendMode::kSrc);
-    paint.setColor(SkColorSetARGB(82, 0, 0, 0));
-    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 1.f));
-    c.drawRoundRect(roundRect, borderRadius, borderRadius, paint);
-    paint.setMaskFilter(nullptr);
-    roundRect.offset(0.f, -0.5f);
-
-    // Border
-    paint.setBlendMode(SkBlendMode::kSrcOver);
-    paint.setStroke(true);
-    paint.setStrokeWidth(1.f);
-    paint.setColor(SkColorSetARGB(9, 0, 0, 0));
-    c.drawRoundRect(roundRect, borderRadius, borderRadius, paint);
-
-    // Fill
-    paint.setBlendMode(SkBlendMode::kSrc);
-    paint.setStroke(false);
-    paint.setColor(SK_ColorWHITE);
-    c.drawRoundRect(roundRect, borderRadius, borderRadius, paint);
-
-    m_textFieldRoundHThreePatchImage[scale] = surface->image();
-    return surface->image();
+    m_assetCache.add(key, image, AKAssetCache::ImageBytes(image));
+    return image;
 }
 
 std::shared_ptr<RImage> CZ::AKTheme::textCaretVThreePatchImage(Int32 scale) noexcept
 {
-    const auto it { m_textCaretVThreePatchImage.find(scale) };
+    const SkISize size(
+        TextCaretVThreePatchSideSrcRect.width(),
+        TextCaretVThreePatchSideSrcRect.height() + TextCaretVThreePatchCenterSrcRect.height());
 
-    if (it != m_textCaretVThreePatchImage.end())
-        return it->second;
+    const auto key { AKAssetCache::MakeKey(AKAssetCache::Kind::TextCaretPatch, size.width(), size.height(), scale) };
 
-    auto surface = RSurface::Make(SkISize(TextCaretVThreePatchSideSrcRect.width(),
-                                          TextCaretVThreePatchSideSrcRect.height() + TextCaretVThreePatchCenterSrcRect.height()),
-                                   scale, true);
+    if (auto image = m_assetCache.get<RImage>(key))
+        return image;
 
-    auto pass { surface->beginPass(RPassCap_SkCanvas) };
-    auto &c { *pass->getCanvas() };
-
-    // c.scale(surface->scale(), surface->scale());
-    c.clear(SK_ColorTRANSPARENT);
+    auto image { makeRasterImage(key, size, scale, [size](SkCanvas &c) {
+        const SkScalar borderRadius { size.width() * 0.5f };
+        SkRect roundRect { SkRect::MakeWH(size.width(), size.height() * 2) };
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setStroke(false);
+        paint.setColor(SK_ColorWHITE);
+        c.drawRoundRect(roundRect, borderRadius, borderRadius, paint);
+    })};
 
-    const SkScalar borderRadius { surface->geometry().viewport.width() * 0.5f };
-    SkRect roundRect { SkRect::MakeWH(surface->geometry().viewport.width(), surface->geometry().viewport.height() * 2) };
-    SkPaint paint;
-    paint.setAntiAlias(true);
-    paint.setBlendMode(SkBlendMode::kSrc);
-    paint.setStroke(false);
-    paint.setColor(SK_ColorWHITE);
-    c.drawRoundRect(roundRect, borderRadius, borderRadius, paint);
-
-    m_textCaretVThreePatchImage[scale] = surface->image();
-    return surface->image();
+    m_assetCache.add(key, image, AKAssetCache::ImageBytes(image));
+    return image;
 }
 
 std::shared_ptr<RImage> CZ::AKTheme::roundLineThreePatchImage(CZOrientation orientation, Int32 diam, Int32 scale, SkRect *outSideSrc, SkRect *outCenterSrc) noexcept
@@ -249,41 +190,34 @@ std::shared_ptr<RImage> CZ::AKTheme::roundLineThreePatchImage(CZOrientation orie
         outCenterSrc->setXYWH(rad + 1.f, 0.f, 1.f, diam);
     }
 
-    auto &orientationMap { m_roundLineThreePatchImage[orientation] };
-    auto &scaleMap { orientationMap[scale] };
-
-    auto it { scaleMap.find(diam) };
+    const auto key { AKAssetCache::MakeKey(AKAssetCache::Kind::RoundLinePatch, orientation, diam, scale) };
 
-    if (it != scaleMap.end())
-        return it->second;
+    if (auto image = m_assetCache.get<RImage>(key))
+        return image;
 
-    auto surface = RSurface::Make(
-        SkISize(
-            orientation == CZOrientation::V ? diam : rad + 2.f,
-            orientation == CZOrientation::V ? rad + 2.f : diam),
-        scale, true);
+    const SkISize size(
+        orientation == CZOrientation::V ? diam : rad + 2.f,
+        orientation == CZOrientation::V ? rad + 2.f : diam);
 
-    auto pass { surface->beginPass(RPassCap_SkCanvas) };
-    auto &c { *pass->getCanvas() };
-
-    // c.scale(surface->scale(), surface->scale());
-    c.clear(SK_ColorTRANSPARENT);
+    const SkRect centerSrc { *outCenterSrc };
 
-    SkPaint paint;
-    paint.setAntiAlias(true);
-    paint.setBlendMode(SkBlendMode::kSrc);
-    paint.setStroke(false);
-    paint.setColor(SK_ColorWHITE);
+    auto image { makeRasterImage(key, size, scale, [orientation, rad, centerSrc](SkCanvas &c) {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setStroke(false);
+        paint.setColor(SK_ColorWHITE);
 
-    if (orientation == CZOrientation::V)
-        c.drawCircle(SkPoint(rad, rad + 1.f), rad, paint);
-    else
-        c.drawCircle(SkPoint(rad + 1.f, rad), rad, paint);
+        if (orientation == CZOrientation::V)
+            c.drawCircle(SkPoint(rad, rad + 1.f), rad, paint);
+        else
+            c.drawCircle(SkPoint(rad + 1.f, rad), rad, paint);
 
-    c.drawRect(*outCenterSrc, paint);
+        c.drawRect(centerSrc, paint);
+    })};
 
-    scaleMap[diam] = surface->image();
-    return surface->image();
+    m_assetCache.add(key, image, AKAssetCache::ImageBytes(image));
+    return image;
 }
 
 std::shared_ptr<RImage> CZ::AKTheme::scrollRailThreePatchImage(CZOrientation orientation, Int32 scale, SkRect *outSideSrc, SkRect *outCenterSrc) noexcept
@@ -302,76 +236,64 @@ std::shared_ptr<RImage> CZ::AKTheme::scrollRailThreePatchImage(CZOrientation ori
         outCenterSrc->setXYWH(2.f, 0.f, 1.f, 1.f);
     }
 
-    auto &orientationMap { m_scrollRailThreePatchImage[orientation] };
-    auto it { orientationMap.find(scale) };
-
-    if (it != orientationMap.end())
-        return it->second;
-
-    auto surface = RSurface::Make(
-        SkISize(
-            orientation == CZOrientation::V ? 1.f : 3.f,
-            orientation == CZOrientation::V ? 3.f : 1.f),
-        scale, true);
-
-    auto pass { surface->beginPass(RPassCap_SkCanvas) };
-    auto &c { *pass->getCanvas() };
+    const auto key { AKAssetCache::MakeKey(AKAssetCache::Kind::ScrollRailPatch, orientation, scale) };
 
-    // c.scale(surface->scale(), surface->scale());
-    c.clear(SkColorSetARGB(255, 251, 251, 251));
+    if (auto image = m_assetCache.get<RImage>(key))
+        return image;
 
-    SkPaint paint;
-    paint.setAntiAlias(true);
-    paint.setBlendMode(SkBlendMode::kSrcOver);
-    paint.setStroke(true);
-    paint.setStrokeWidth(1.f);
-    paint.setColor(SkColorSetARGB(25, 0, 0, 0));
+    const SkISize size(
+        orientation == CZOrientation::V ? 1 : 3,
+        orientation == CZOrientation::V ? 3 : 1);
 
-    if (orientation == CZOrientation::V)
-        c.drawLine(-5.f, 0.f, 5.f, 0.f, paint);
-    else
-        c.drawLine(0.f, -5.f, 0.f, 5.f, paint);
+    auto image { makeRasterImage(key, size, scale, [orientation](SkCanvas &c) {
+        c.clear(SkColorSetARGB(255, 251, 251, 251));
 
-    orientationMap[scale] = surface->image();
-    return surface->image();
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setBlendMode(SkBlendMode::kSrcOver);
+        paint.setStroke(true);
+        paint.setStrokeWidth(1.f);
+        paint.setColor(SkColorSetARGB(25, 0, 0, 0));
+
+        if (orientation == CZOrientation::V)
+            c.drawLine(-5.f, 0.f, 5.f, 0.f, paint);
+        else
+            c.drawLine(0.f, -5.f, 0.f, 5.f, paint);
+    })};
+
+    m_assetCache.add(key, image, AKAssetCache::ImageBytes(image));
+    return image;
 }
 
 std::shared_ptr<RImage> CZ::AKTheme::edgeShadowImage(Int32 scale) noexcept
 {
-    const auto it { m_edgeShadowImage.find(scale) };
-
-    if (it != m_edgeShadowImage.end())
-        return it->second;
+    const auto key { AKAssetCache::MakeKey(AKAssetCache::Kind::EdgeShadow, EdgeShadowRadius, scale) };
 
-    auto surface = RSurface::Make(SkISize(1, EdgeShadowRadius), scale, true);
-    auto pass { surface->beginPass(RPassCap_SkCanvas) };
-    auto &c { *pass->getCanvas() };
+    if (auto image = m_assetCache.get<RImage>(key))
+        return image;
 
-    // c.scale(surface->scale(), surface->scale());
-    c.clear(SK_ColorTRANSPARENT);
-
-    SkPaint paint;
-    paint.setColor(SK_ColorWHITE);
-    paint.setBlendMode(SkBlendMode::kSrc);
-    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, SkScalar(EdgeShadowRadius)/3.f));
-    c.drawIRect(SkIRect::MakeXYWH(-100, -100, 200, 100), paint);
+    auto image { makeRasterImage(key, SkISize(1, EdgeShadowRadius), scale, [radius = EdgeShadowRadius](SkCanvas &c) {
+        SkPaint paint;
+        paint.setColor(SK_ColorWHITE);
+        paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, SkScalar(radius)/3.f));
+        c.drawIRect(SkIRect::MakeXYWH(-100, -100, 200, 100), paint);
+    })};
 
-    m_edgeShadowImage[scale] = surface->image();
-    return surface->image();
+    m_assetCache.add(key, image, AKAssetCache::ImageBytes(image));
+    return image;
 }
 
 std::shared_ptr<RImage> CZ::AKTheme::windowButtonImage(Int32 scale, AKWindowButton::Type type, AKWindowButton::State state)
 {
     CZ_UNUSED(scale)
 
-    // Being lazy and always using scale 2
+    // Being lazy and always using scale 2, so the scale is not part of the key
 
-    auto &typeMap { m_windowButtons[scale] };
-    auto &stateMap { typeMap[type] };
-    auto it { stateMap.find(state) };
+    const auto key { AKAssetCache::MakeKey(AKAssetCache::Kind::WindowButton, type, state) };
 
-    if (it != stateMap.end())
-        return it->second;
+    if (auto image = m_assetCache.get<RImage>(key))
+        return image;
 
     std::shared_ptr<RImage> image;
 
@@ -451,9 +373,168 @@ std::shared_ptr<RImage> CZ::AKTheme::windowButtonImage(Int32 scale, AKWindowButt
     }
 
     if (image)
+        m_assetCache.add(key, image, AKAssetCache::ImageBytes(image));
+
+    return image;
+}
+
+std::shared_ptr<AKAsset::RRect9Patch> CZ::AKTheme::roundRect9Patch(Int32 radius, Int32 scale, SkColor backgroundColor, Int32 strokeWidth, SkColor strokeColor) noexcept
+{
+    if (radius <= 0) radius = 1;
+    if (scale <= 0) scale = 1;
+    if (strokeWidth < 0 || SkColorGetA(strokeColor) == 0) strokeWidth = 0;
+
+    const auto key { AKAssetCache::MakeKey(AKAssetCache::Kind::RRect9Patch, radius, scale, backgroundColor, strokeWidth, strokeColor) };
+
+    if (auto asset = m_assetCache.get<AKAsset::RRect9Patch>(key))
+        return asset;
+
+    const auto rad { std::max(radius, strokeWidth) };
+    const SkIRect center { SkIRect::MakeXYWH(rad, rad, 1, 1) };
+    const auto size { SkISize(rad * 2 + 1, rad * 2 + 1) };
+
+    auto image { makeRasterImage(key, size, scale, [=](SkCanvas &c) {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setBlendMode(SkBlendMode::kSrc);
+
+        const auto rect { SkRect::Make(size) };
+
+        if (SkColorGetA(backgroundColor) > 0)
+        {
+            paint.setStroke(false);
+            paint.setColor(backgroundColor);
+            c.drawRoundRect(rect, radius, radius, paint);
+        }
+
+        if (strokeWidth > 0)
+        {
+            paint.setStroke(true);
+            paint.setColor(strokeColor);
+            paint.setStrokeWidth(strokeWidth);
+            const SkScalar inset { SkScalar(strokeWidth) * 0.5f };
+            const auto sRad { std::max(0.f, radius - inset) };
+            c.drawRoundRect(rect.makeInset(inset, inset), sRad, sRad, paint);
+        }
+    })};
+
+    if (!image)
+        return {};
+
+    auto asset { std::make_shared<AKAsset::RRect9Patch>(image, center) };
+    m_assetCache.add(key, asset, AKAssetCache::ImageBytes(image));
+    return asset;
+}
+
+std::shared_ptr<RImage> CZ::AKTheme::firstQuadrantCircleMask(Int32 radius, Int32 scale) noexcept
+{
+    if (radius <= 0) radius = 1;
+    if (scale <= 0) scale = 1;
+
+    const auto key { AKAssetCache::MakeKey(AKAssetCache::Kind::CircleMask, radius, scale) };
+
+    if (auto image = m_assetCache.get<RImage>(key))
+        return image;
+
+    auto image { makeRasterImage(key, SkISize(radius, radius), scale, [radius](SkCanvas &c) {
+        SkPaint paint;
+        paint.setStroke(false);
+        paint.setAntiAlias(true);
+        paint.setColor(SK_ColorWHITE);
+        paint.setBlendMode(SkBlendMode::kSrc);
+        c.drawCircle(SkPoint::Make(radius, radius), radius, paint);
+    }, false)};
+
+    m_assetCache.add(key, image, AKAssetCache::ImageBytes(image));
+    return image;
+}
+
+bool CZ::AKTheme::enableAssetDiskCache(const std::filesystem::path &dir) noexcept
+{
+    return m_assetCache.enableDiskCache(assetsVersion(), dir);
+}
+
+// Thread-safe, only touches the bitmap
+static bool RasterizeAsset(SkBitmap &bitmap, const SkImageInfo &info, Int32 scale, const std::function<void(SkCanvas&)> &draw) noexcept
+{
+    if (!bitmap.tryAllocPixels(info))
+        return false;
+
+    SkCanvas c { bitmap };
+    c.clear(SK_ColorTRANSPARENT);
+    c.scale(scale, scale);
+    draw(c);
+    return true;
+}
+
+std::shared_ptr<RImage> CZ::AKTheme::makeRasterImage(const AKAssetCache::Key &key, SkISize size, Int32 scale, std::function<void(SkCanvas&)> draw, bool allowAsync) noexcept
+{
+    if (const auto it = m_asyncReady.find(key); it != m_asyncReady.end())
     {
-        stateMap[state] = image;
+        auto image { std::move(it->second) };
+        m_asyncReady.erase(it);
+        return image;
     }
 
-    return image;
+    if (auto image = m_assetCache.loadImage(key))
+        return image;
+
+    // Use raster for pixel perfect drawing
+
+    const auto info { SkImageInfo::Make(
+        size.width() * scale,
+        size.height() * scale,
+        RSKFormat::FromDRM(DRM_FORMAT_ARGB8888),
+        kPremul_SkAlphaType) };
+
+    if (allowAsync && m_asyncAssets)
+    {
+        if (m_asyncPending.contains(key))
+            return {};
+
+        m_asyncPending.insert(key);
+        auto bitmap { std::make_shared<SkBitmap>() };
+
+        AKApp::Get()->runAsync(
+            [bitmap, info, scale, draw = std::move(draw)] {
+                RasterizeAsset(*bitmap, info, scale, draw);
+            },
+            [this, alive = std::weak_ptr<bool>(m_alive), key, bitmap] {
+                // The theme was replaced
+                if (alive.expired())
+                    return;
+
+                m_asyncPending.erase(key);
+
+                if (bitmap->drawsNothing())
+                {
+                    AKLog(CZError, CZLN, "Failed to allocate SkBitmap pixels");
+                    return;
+                }
+
+                m_assetCache.storePixels(key, bitmap->pixmap());
+
+                if (auto image = AKAssetCache::MakeImage(bitmap->pixmap()))
+                {
+                    m_asyncReady[key] = image;
+                    onAssetsReady.notify();
+
+                    if (auto app { AKApp::Get() })
+                        app->notifyAssetsReady();
+                }
+            });
+
+        return {};
+    }
+
+    SkBitmap bitmap;
+
+    if (!RasterizeAsset(bitmap, info, scale, draw))
+    {
+        AKLog(CZError, CZLN, "Failed to allocate SkBitmap pixels");
+        return {};
+    }
+
+    m_assetCache.storePixels(key, bitmap.pixmap());
+    return AKAssetCache::MakeImage(bitmap.pixmap());
 }
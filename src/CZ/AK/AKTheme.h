@@ -6,13 +6,16 @@
 #include <CZ/skia/core/SkImage.h>
 #include <CZ/skia/core/SkRegion.h>
 #include <CZ/skia/core/SkFont.h>
+#include <CZ/skia/core/SkCanvas.h>
 #include <CZ/AK/ThirdParty/Material/dynamiccolor/dynamic_scheme.h>
 #include <CZ/AK/Nodes/AKWindowButton.h>
+#include <CZ/AK/AKAssetCache.h>
 #include <CZ/AK/AK.h>
 #include <CZ/Ream/Ream.h>
 #include <CZ/Core/CZOrientation.h>
-#include <CZ/Core/CZAssetManager.h>
-#include <unordered_map>
+#include <CZ/Core/CZSignal.h>
+#include <unordered_set>
+#include <functional>
 
 namespace CZ
 {
@@ -34,6 +37,53 @@ public:
 
     std::shared_ptr<AKColorTheme> colorTheme() noexcept { return m_colorTheme; }
 
+    /**
+     * @brief Cache of the generated assets.
+     *
+     * Can be used to adjust the memory budget, query statistics or trim() on low-memory situations.
+     */
+    AKAssetCache &assetCache() noexcept { return m_assetCache; }
+
+    /**
+     * @brief Version of the procedurally generated assets.
+     *
+     * Identifies the pixels stored in the disk cache. Subclasses that change how assets are drawn
+     * must return a different value.
+     */
+    static constexpr UInt64 AssetsVersion { 1 };
+    virtual UInt64 assetsVersion() const noexcept { return AssetsVersion; }
+
+    /**
+     * @brief Enables the on-disk cache of generated assets.
+     *
+     * Assets found on disk are uploaded directly instead of being drawn again, which speeds up
+     * startup and scale changes. Disabled by default.
+     *
+     * @param dir Cache directory, AKAssetCache::DefaultDiskCacheDir() if empty.
+     * @return true on success, false if the directory could not be created.
+     */
+    bool enableAssetDiskCache(const std::filesystem::path &dir = {}) noexcept;
+
+    /**
+     * @brief Enables asynchronous asset generation.
+     *
+     * When enabled, an asset factory called on a cache miss starts rasterizing on a worker thread and returns nullptr.
+     * Once the pixels are uploaded, onAssetsReady is triggered and the next call to the same factory returns the asset.
+     * Nodes keep their previous image meanwhile. Disabled by default.
+     *
+     * The first quadrant circle masks are always generated synchronously, since they are requested while rendering.
+     */
+    void setAsyncAssets(bool enabled) noexcept { m_asyncAssets = enabled; }
+    bool asyncAssets() const noexcept { return m_asyncAssets; }
+
+    /**
+     * @brief Triggered when asynchronously generated assets are ready.
+     *
+     * Nodes that got nullptr from a factory should request the asset again. Nodes use AKNode::setAssetPending()
+     * instead, which also covers theme replacement.
+     */
+    CZSignal<> onAssetsReady;
+
     /* Colors */
 
     static inline SkColor   Blue                { 0xFF3498DB };
@@ -58,7 +108,12 @@ public:
 
     /* Fonts */
 
-    static inline SkFont    DefaultFont;
+    /**
+     * @brief Default font.
+     *
+     * The typeface is resolved on the first call, to avoid querying fontconfig at startup.
+     */
+    static const SkFont &DefaultFont() noexcept;
     skia::textlayout::TextStyle   DefaultTextStyle;
     skia::textlayout::TextStyle   ButtonTextStyle;
 
@@ -106,45 +161,44 @@ public:
     virtual std::shared_ptr<RImage>  windowButtonImage              (Int32 scale, AKWindowButton::Type type, AKWindowButton::State state);
 
     /* First quadrant of a circle white-filled */
-    CZAssetManager<RImage, Int32 /*radius*/, Int32 /*scale*/> FirstQuadrantCircleMask;
+    virtual std::shared_ptr<RImage>  firstQuadrantCircleMask        (Int32 radius, Int32 scale) noexcept;
 
-    /* Icon Font (could be nullptr) */
-    std::shared_ptr<AKIconFont> iconFont;
+    /**
+     * @brief Default icon font (could be nullptr).
+     *
+     * Loaded on first use, since it requires the font collection and parsing the codepoints file.
+     */
+    std::shared_ptr<AKIconFont> iconFont() noexcept;
+    void setIconFont(std::shared_ptr<AKIconFont> iconFont) noexcept;
 
     /* Solid round container 9-patch */
-    CZAssetManager<AKAsset::RRect9Patch, Int32 /*radius*/, Int32 /*scale*/, SkColor /*backgroundColor*/, Int32 /*strokeWidth*/, SkColor /*strokeColor*/> RRect9Patch;
+    virtual std::shared_ptr<AKAsset::RRect9Patch> roundRect9Patch   (Int32 radius, Int32 scale, SkColor backgroundColor, Int32 strokeWidth, SkColor strokeColor) noexcept;
 
 protected:
 
-    std::shared_ptr<AKColorTheme> m_colorTheme;
-
-    /* AKButton */
-    std::unordered_map<Int32,std::shared_ptr<RImage>> m_buttonPlainHThreePatchImage;
-    std::unordered_map<Int32,std::shared_ptr<RImage>> m_buttonTintedHThreePatchImage;
-
-    /* AKTextField */
-    std::unordered_map<Int32,std::shared_ptr<RImage>> m_textFieldRoundHThreePatchImage;
-    std::unordered_map<Int32,std::shared_ptr<RImage>> m_textCaretVThreePatchImage;
+    /**
+     * @brief Rasterizes an asset with the CPU.
+     *
+     * The canvas is cleared and pre-scaled, so `draw` uses logical coordinates.
+     * Pixels are loaded from/stored into the disk cache when enabled. The result is not added to assetCache().
+     *
+     * If asyncAssets() is enabled and `allowAsync` is true, `draw` runs on a worker thread and nullptr is returned
+     * until the asset is ready (see onAssetsReady), so it must only capture values.
+     *
+     * @param size Size in logical coordinates.
+     */
+    std::shared_ptr<RImage> makeRasterImage(const AKAssetCache::Key &key, SkISize size, Int32 scale, std::function<void(SkCanvas&)> draw, bool allowAsync = true) noexcept;
 
-    /* AKEdgeShadow */
-    std::unordered_map<Int32,std::shared_ptr<RImage>> m_edgeShadowImage;
-
-    /* AKWindowButton [scale][type][state] */
-    std::unordered_map<Int32,
-        std::unordered_map<AKWindowButton::Type,
-            std::unordered_map<AKWindowButton::State,
-                std::shared_ptr<RImage>>>> m_windowButtons;
-
-    /* Round Line Patch [orientation][scale][diam] */
-    std::unordered_map<CZOrientation,
-        std::unordered_map<Int32,
-            std::unordered_map<Int32,
-                std::shared_ptr<RImage>>>> m_roundLineThreePatchImage;
-
-    /* Round Line Patch [orientation][scale] */
-    std::unordered_map<CZOrientation,
-        std::unordered_map<Int32,
-            std::shared_ptr<RImage>>> m_scrollRailThreePatchImage;
+    std::shared_ptr<AKColorTheme> m_colorTheme;
+    AKAssetCache m_assetCache;
+    std::shared_ptr<AKIconFont> m_iconFont;
+    bool m_iconFontLoaded { false };
+
+    // Async asset generation
+    bool m_asyncAssets { false };
+    std::unordered_set<AKAssetCache::Key, AKAssetCache::KeyHash> m_asyncPending;
+    std::unordered_map<AKAssetCache::Key, std::shared_ptr<RImage>, AKAssetCache::KeyHash> m_asyncReady;
+    std::shared_ptr<bool> m_alive { std::make_shared<bool>(true) };
 };
 
 #endif // CZ_AKTHEME_H
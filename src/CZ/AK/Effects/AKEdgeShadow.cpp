@@ -10,7 +10,7 @@ AKEdgeShadow::AKEdgeShadow(CZEdge edge, AKNode *parent) noexcept : AKImage(paren
     setEdge(edge);
     enableReplaceImageColor(true);
     setColor(AKTheme::EdgeShadowColor);
-    setImage(theme()->edgeShadowImage(scale()));
+    updateImage();
 }
 
 void AKEdgeShadow::setEdge(CZEdge edge) noexcept
@@ -55,9 +55,23 @@ void AKEdgeShadow::layoutEvent(const CZLayoutEvent &event)
 {
     AKImage::layoutEvent(event);
     if (event.changes.has(CZLayoutChangeScale))
-    {
-        setImage(theme()->edgeShadowImage(scale()));
-        addDamage(AK_IRECT_INF);
-    }
+        updateImage();
     event.accept();
 }
+
+void AKEdgeShadow::updateImage() noexcept
+{
+    auto image { theme()->edgeShadowImage(scale()) };
+    setAssetPending(!image);
+
+    if (!image)
+        return;
+
+    setImage(image);
+    addDamage(AK_IRECT_INF);
+}
+
+void AKEdgeShadow::assetsReadyEvent()
+{
+    updateImage();
+}
@@ -21,6 +21,8 @@ public:
 protected:
     CZEdge m_edge;
     void layoutEvent(const CZLayoutEvent &event) override;
+    void assetsReadyEvent() override;
+    void updateImage() noexcept;
 };
 
 #endif // CZ_AKEDGESHADOW_H
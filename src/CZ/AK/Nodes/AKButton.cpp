@@ -18,9 +18,11 @@ AKButton::AKButton(const std::string &text, AKNode *parent) noexcept :
     m_icon("star", 32, this),
     m_text(text, this)
 {
-    auto the { colorTheme() };
-    const auto &scheme { the->scheme(colorScheme()) };
-    setColor(scheme.GetPrimary());
+    // Colors follow setColorScheme() and setColorTheme() through the bindings, updateStyle() only
+    // reruns when the interaction state changes (see onSceneBegin())
+    bindColor(AKColorRole::Primary, [this](SkColor color) { setBackgroundColor(color); });
+    bindColor(AKColorRole::OnPrimary, [this](SkColor color) { m_icon.setColor(color); });
+    bindColor(AKColorRole::OnPrimary, [this](SkColor color) { m_text.setColor(color); });
     SkRegion empty;
     setCursor(CZCursorShape::Pointer);
     layout().setPadding(YGEdgeAll, 8.f);
@@ -30,6 +32,7 @@ AKButton::AKButton(const std::string &text, AKNode *parent) noexcept :
     m_text.setTextStyle(theme()->ButtonTextStyle);
     m_text.setInputRegion(&empty);
     m_text.enableReplaceImageColor(true);
+    m_styleState = styleState();
     updateStyle();
 }
 
@@ -57,7 +60,15 @@ void AKButton::setPressed(bool pressed) noexcept
 
 void AKButton::onSceneBegin()
 {
-    updateStyle();
+    // The pointer-over state is polled since the button can move under the pointer without events
+    const StyleState state { styleState() };
+
+    if (state != m_styleState)
+    {
+        m_styleState = state;
+        updateStyle();
+    }
+
     AKRoundSolidColor::onSceneBegin();
 }
 
@@ -94,6 +105,11 @@ void AKButton::windowStateEvent(const CZWindowStateEvent &event)
     event.accept();
 }
 
+AKButton::StyleState AKButton::styleState() const noexcept
+{
+    return { isPointerOver(), m_enabled, m_pressed, m_type, m_variant };
+}
+
 void AKButton::updateStyle() noexcept
 {
     switch (m_variant)
@@ -106,7 +122,7 @@ void AKButton::updateStyle() noexcept
 
 void AKButton::updateStyleFilled() noexcept
 {
-    const auto &scheme { colorTheme()->scheme(colorScheme()) };
+    const SkColor onPrimary { colorTheme()->color(AKColorRole::OnPrimary, colorScheme()) };
 
     if (m_type == Type::Default)
     {
@@ -121,16 +137,13 @@ void AKButton::updateStyleFilled() noexcept
             layout().setPadding(YGEdgeRight, 24);
             layout().setGap(YGGutterAll, 8);
             setBorderRadius(20);
-            setBackgroundColor(scheme.GetPrimary());
             setStrokeWidth(0);
             m_shadow.reset();
             m_icon.setSize(20);
-            m_icon.setColor(scheme.GetOnPrimary());
             auto textStyle { m_text.textStyle() };
             textStyle.setFontSize(14);
             textStyle.setFontStyle(SkFontStyle(SkFontStyle::kMedium_Weight, SkFontStyle::kNormal_Width, SkFontStyle::kUpright_Slant));
             m_text.setTextStyle(textStyle);
-            m_text.setColor(scheme.GetOnPrimary());
         }
         else
         {
@@ -144,18 +157,16 @@ void AKButton::updateStyleFilled() noexcept
             layout().setGap(YGGutterAll, 8);
             setBorderRadius(20);
 
-            SkColor4f overlay { SkColor4f::FromColor(scheme.GetOnPrimary()) };
+            SkColor4f overlay { SkColor4f::FromColor(onPrimary) };
             overlay.fA = 0.08f;
-            //setBackgroundColor(SkColorOverInt(scheme.GetPrimary(), overlay.toSkColor()));
+            //setBackgroundColor(SkColorOverInt(primary, overlay.toSkColor()));
             setStrokeWidth(0);
             m_shadow.reset();
             m_icon.setSize(20);
-            m_icon.setColor(scheme.GetOnPrimary());
             auto textStyle { m_text.textStyle() };
             textStyle.setFontSize(14);
             textStyle.setFontStyle(SkFontStyle(SkFontStyle::kMedium_Weight, SkFontStyle::kNormal_Width, SkFontStyle::kUpright_Slant));
             m_text.setTextStyle(textStyle);
-            m_text.setColor(scheme.GetOnPrimary());
         }
     }
     else // Toggle
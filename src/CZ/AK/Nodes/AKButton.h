@@ -66,6 +66,16 @@ protected:
     void onSceneBegin() override;
     void pointerButtonEvent(const CZPointerButtonEvent &event) override;
     void windowStateEvent(const CZWindowStateEvent &event) override;
+    /* State updateStyle() depends on, colors are excluded since they follow the role bindings */
+    struct StyleState
+    {
+        bool pointerOver, enabled, pressed;
+        Type type;
+        Variant variant;
+        bool operator==(const StyleState &other) const noexcept = default;
+    };
+
+    StyleState styleState() const noexcept;
     void updateStyle() noexcept;
     void updateStyleFilled() noexcept;
     AKFontIcon m_icon;
@@ -78,6 +88,9 @@ protected:
     Variant m_variant { Variant::Filled };
     Size m_size { Size::Small };
     Shape m_shape { Shape::Round };
+
+    // State of the last updateStyle() call
+    StyleState m_styleState {};
 };
 
 #endif // CZ_AKBUTTON_H
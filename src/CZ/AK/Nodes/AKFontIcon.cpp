@@ -48,28 +48,28 @@ void AKFontIcon::setSize(UInt32 size) noexcept
 
 void AKFontIcon::setIconFromName(const std::string &iconName) noexcept
 {
-    if (!m_isUTF8 && m_icon == iconName)
+    if (!m_isUTF8 && m_iconName == iconName)
         return;
 
     m_isUTF8 = false;
-    m_icon = iconName;
+    m_iconName = iconName;
     addChange(CHIcon);
 }
 
 void AKFontIcon::setIconFromUTF8(const std::string &utf8) noexcept
 {
-    if (m_isUTF8 && m_icon == utf8)
+    if (m_isUTF8 && m_iconName == utf8)
         return;
 
     m_isUTF8 = true;
-    m_icon = utf8;
+    m_iconName = utf8;
     addChange(CHIcon);
 }
 
 void AKFontIcon::setIconFont(std::shared_ptr<AKIconFont> iconFont) noexcept
 {
     if (!iconFont)
-        iconFont = theme()->iconFont;
+        iconFont = theme()->iconFont();
 
     if (iconFont == m_iconFont)
         return;
@@ -85,15 +85,17 @@ void AKFontIcon::onSceneBegin()
         if (m_iconFont)
         {
             if (isUTF8())
-                m_image = m_iconFont->getIconByUTF8(m_icon, worldRect().width() * scale());
+                m_icon = m_iconFont->getAtlasIconByUTF8(m_iconName, worldRect().width() * scale());
             else
-                m_image = m_iconFont->getIconByName(m_icon, worldRect().width() * scale());
+                m_icon = m_iconFont->getAtlasIconByName(m_iconName, worldRect().width() * scale());
         }
+        else
+            m_icon = {};
 
         addDamage(AK_IRECT_INF);
     }
 
-    if (m_image)
+    if (m_icon)
         invisibleRegion.setEmpty();
     else
         invisibleRegion.setRect(AK_IRECT_INF);
@@ -107,7 +109,7 @@ void AKFontIcon::renderEvent(const AKRenderEvent &e)
     auto *p { e.pass->getPainter() };
     RDrawImageInfo info {};
     info.image = image();
-    info.src = SkRect::Make(image()->size());
+    info.src = SkRect::Make(imageSrcRect());
     info.dst = e.rect;
     p->drawImage(info, &e.damage);
 }
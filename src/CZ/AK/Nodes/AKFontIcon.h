@@ -2,6 +2,7 @@
 #define AKFONTICON_H
 
 #include <CZ/AK/Nodes/AKRenderable.h>
+#include <CZ/AK/AKIconFont.h>
 
 /**
  * @brief A node that displays a font icon.
@@ -9,7 +10,7 @@
  * This node renders symbols from an AKIconFont using either an icon name or its corresponding UTF-8 code.
  * The icon size is specified in logical coordinates, and the image is automatically regenerated based on the current node's scale factor.
  *
- * If no specific AKIconFont is provided, the default font from AKTheme::fontIcon is used, which is Material Round Icons by default.
+ * If no specific AKIconFont is provided, the default font from AKTheme::iconFont() is used, which is Material Round Icons by default.
  *
  * You can find a list of Material icon names here: https://fonts.google.com/icons?icon.style=Rounded
  *
@@ -82,7 +83,7 @@ public:
      *
      * @return The current icon name or UTF-8 code as a string.
      */
-    const std::string &icon() const noexcept { return m_icon; }
+    const std::string &icon() const noexcept { return m_iconName; }
 
     /**
      * @brief Checks if the last icon was set using setIconFromUTF8() or setIconFromName()
@@ -108,17 +109,23 @@ public:
     /**
      * @brief Gets the image representation of the icon, if available.
      *
+     * The image is an atlas page shared with other icons, see imageSrcRect().
      * If no valid icon is found with the current name, this could return nullptr.
      *
      * @return A shared pointer to the image, or nullptr if no image is found.
      */
-    std::shared_ptr<RImage> image() const noexcept { return m_image; }
+    std::shared_ptr<RImage> image() const noexcept { return m_icon.image; }
+
+    /**
+     * @brief Rect of the icon within image() in buffer coordinates.
+     */
+    const SkIRect &imageSrcRect() const noexcept { return m_icon.src; }
 
 protected:
     void onSceneBegin() override;
     void renderEvent(const AKRenderEvent &event) override;
-    std::string m_icon;
-    std::shared_ptr<RImage> m_image;
+    std::string m_iconName;
+    AKIconFont::Icon m_icon;
     std::shared_ptr<AKIconFont> m_iconFont;
     bool m_isUTF8 {};
 };
@@ -0,0 +1,420 @@
+#include <CZ/Core/Events/CZLayoutEvent.h>
+#include <CZ/AK/Nodes/AKListView.h>
+#include <CZ/AK/AKScene.h>
+#include <cmath>
+#include <bit>
+
+using namespace CZ;
+
+void AKListView::HeightIndex::reset(size_t count, const std::function<SkScalar (size_t)> &estimate) noexcept
+{
+    m_heights.resize(count);
+    m_tree.assign(count + 1, 0.0);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        m_heights[i] = std::max(0.f, estimate(i));
+        m_tree[i + 1] = m_heights[i];
+    }
+
+    // O(n) construction
+    for (size_t i = 1; i <= count; i++)
+    {
+        const size_t parent { i + (i & (~i + 1)) };
+
+        if (parent <= count)
+            m_tree[parent] += m_tree[i];
+    }
+}
+
+void AKListView::HeightIndex::set(size_t index, SkScalar height) noexcept
+{
+    if (index >= m_heights.size())
+        return;
+
+    height = std::max(0.f, height);
+    const double delta { double(height) - double(m_heights[index]) };
+    m_heights[index] = height;
+
+    for (size_t i = index + 1; i < m_tree.size(); i += i & (~i + 1))
+        m_tree[i] += delta;
+}
+
+SkScalar AKListView::HeightIndex::prefix(size_t count) const noexcept
+{
+    double sum { 0.0 };
+
+    for (size_t i = std::min(count, m_heights.size()); i > 0; i -= i & (~i + 1))
+        sum += m_tree[i];
+
+    return sum;
+}
+
+size_t AKListView::HeightIndex::find(SkScalar offset) const noexcept
+{
+    if (m_heights.empty() || offset <= 0.f)
+        return 0;
+
+    // Number of items that end at or before offset
+    size_t pos { 0 };
+    double remaining { offset };
+
+    for (size_t step = std::bit_floor(m_heights.size()); step > 0; step >>= 1)
+    {
+        if (pos + step < m_tree.size() && m_tree[pos + step] <= remaining)
+        {
+            pos += step;
+            remaining -= m_tree[pos];
+        }
+    }
+
+    return std::min(pos, m_heights.size() - 1);
+}
+
+AKListView::AKListView(AKNode *parent) noexcept : AKScroll(parent)
+{
+    SkRegion empty;
+    m_extent.setInputRegion(&empty);
+    m_extent.layout().setPositionType(YGPositionTypeAbsolute);
+    m_extent.layout().setPosition(YGEdgeTop, 0.f);
+    m_extent.layout().setPosition(YGEdgeLeft, 0.f);
+    m_extent.layout().setWidthPercent(100.f);
+    m_extent.layout().setHeight(0.f);
+
+    m_updateTimer.setCallback([this](CZTimer *) {
+        updateRows();
+    });
+}
+
+AKListView::~AKListView()
+{
+    // Rows must be destroyed before the slot
+    m_rows.clear();
+    m_pool.clear();
+}
+
+void AKListView::setDelegate(Delegate *delegate) noexcept
+{
+    if (m_delegate == delegate)
+        return;
+
+    recycleRows();
+    m_pool.clear();
+    m_delegate = delegate;
+    setItemCount(itemCount());
+}
+
+void AKListView::setItemCount(size_t count) noexcept
+{
+    recycleRows();
+
+    m_index.reset(count, [this](size_t index) {
+        return m_delegate ? m_delegate->estimatedRowHeight(index) : DefaultEstimatedRowHeight;
+    });
+
+    updateExtent();
+    applyConstraints(); // Calls updateRows()
+}
+
+void AKListView::setOverscan(UInt32 rows) noexcept
+{
+    if (m_overscan == rows)
+        return;
+
+    m_overscan = rows;
+    updateRows();
+}
+
+void AKListView::invalidateItem(size_t index) noexcept
+{
+    if (auto *row = rowForItem(index))
+    {
+        m_delegate->bindRow(*row, index);
+        m_unmeasuredRows.insert(row);
+        updateRows();
+        repaint();
+    }
+}
+
+void AKListView::reload() noexcept
+{
+    if (!m_delegate)
+        return;
+
+    for (size_t i = 0; i < m_rows.size(); i++)
+    {
+        m_delegate->bindRow(*m_rows[i], m_firstItem + i);
+        m_unmeasuredRows.insert(m_rows[i].get());
+    }
+
+    updateRows();
+    repaint();
+}
+
+void AKListView::scrollToItem(size_t index) noexcept
+{
+    if (itemCount() == 0)
+        return;
+
+    calculateContentBounds();
+    setOffsetY(-itemOffset(std::min(index, itemCount() - 1)));
+}
+
+AKNode *AKListView::rowForItem(size_t index) const noexcept
+{
+    if (index < m_firstItem || index >= m_firstItem + m_rows.size())
+        return nullptr;
+
+    return m_rows[index - m_firstItem].get();
+}
+
+void AKListView::onSceneBegin()
+{
+    AKScroll::onSceneBegin();
+
+    if (m_extentChanged)
+    {
+        m_extentChanged = false;
+        calculateContentBounds();
+        updateBarYPrivate();
+    }
+
+    /* Rows are measured before the layout pass (see measureRows()), a different height here means the row
+     * changed on its own or couldn't be measured yet. It's already presented, so it's moved on the next frame */
+    const size_t anchor { itemAt(-offsetY()) };
+    SkScalar anchorShift { 0.f };
+    bool changed { false };
+
+    for (size_t i = 0; i < m_rows.size(); i++)
+    {
+        const size_t index { m_firstItem + i };
+        const SkScalar height { m_rows[i]->layout().calculatedHeight() };
+
+        if (std::isnan(height) || height == itemHeight(index))
+            continue;
+
+        if (index < anchor)
+            anchorShift += height - itemHeight(index);
+
+        m_index.set(index, height);
+        changed = true;
+    }
+
+    if (!changed)
+        return;
+
+    updateExtent();
+    m_extentChanged = true;
+
+    if (anchorShift != 0.f)
+        m_slot.setRenderOffset({ offsetX(), offsetY() - anchorShift });
+
+    positionRows();
+    m_updateTimer.start(0);
+    repaint();
+}
+
+void AKListView::onOffsetChanged() noexcept
+{
+    AKScroll::onOffsetChanged();
+    updateRows();
+}
+
+void AKListView::layoutEvent(const CZLayoutEvent &e)
+{
+    AKScroll::layoutEvent(e);
+
+    if (e.changes.has(CZLayoutChangeSize))
+        updateRows();
+}
+
+void AKListView::updateRows() noexcept
+{
+    // Binding may trigger nested offset changes
+    if (m_updatingRows)
+        return;
+
+    // Rows added during AKScene::render() would be presented before being laid out
+    if (scene() && scene()->currentTarget())
+    {
+        m_updateTimer.start(0);
+        return;
+    }
+
+    if (!m_delegate || itemCount() == 0)
+    {
+        recycleRows();
+        return;
+    }
+
+    m_updatingRows = true;
+
+    // Keeps the first visible item in place when the rows above it are measured
+    const size_t anchor { itemAt(-offsetY()) };
+    bool measured { false };
+
+    // Measured heights can bring more rows into view, which are measured in the next pass
+    for (int pass = 0; pass < 4; pass++)
+    {
+        updateRange();
+
+        SkScalar anchorShift { 0.f };
+
+        if (!measureRows(anchor, &anchorShift))
+            break;
+
+        measured = true;
+
+        // Applied before the layout pass, so unlike moveYPrivate() it isn't clamped to the outdated content bounds
+        if (anchorShift != 0.f)
+            m_slot.setRenderOffset({ offsetX(), offsetY() - anchorShift });
+    }
+
+    if (measured)
+    {
+        updateExtent();
+        positionRows();
+        m_extentChanged = true;
+    }
+
+    m_updatingRows = false;
+}
+
+void AKListView::updateRange() noexcept
+{
+    const SkScalar top { -offsetY() };
+    size_t first { itemAt(top) };
+    size_t last { itemAt(top + layout().calculatedHeight()) + 1 };
+    first = first > m_overscan ? first - m_overscan : 0;
+    last = std::min(itemCount(), last + m_overscan);
+
+    // No overlap, everything is recycled
+    if (m_rows.empty() || first >= m_firstItem + m_rows.size() || last <= m_firstItem)
+    {
+        recycleRows();
+        m_firstItem = first;
+    }
+
+    // Drop the rows out of range
+    while (!m_rows.empty() && m_firstItem < first)
+    {
+        recycleRow(std::move(m_rows.front()), m_firstItem);
+        m_rows.pop_front();
+        m_firstItem++;
+    }
+
+    while (!m_rows.empty() && m_firstItem + m_rows.size() > last)
+    {
+        recycleRow(std::move(m_rows.back()), m_firstItem + m_rows.size() - 1);
+        m_rows.pop_back();
+    }
+
+    if (m_rows.empty())
+        m_firstItem = first;
+
+    // Add the missing ones
+    while (m_firstItem > first)
+    {
+        m_firstItem--;
+        m_rows.emplace_front(takeRow(m_firstItem));
+    }
+
+    while (m_firstItem + m_rows.size() < last)
+        m_rows.emplace_back(takeRow(m_firstItem + m_rows.size()));
+}
+
+bool AKListView::measureRows(size_t anchor, SkScalar *anchorShift) noexcept
+{
+    // Same constraints the slot gives the rows, unknown until the list is laid out for the first time
+    const SkScalar width { m_slot.layout().calculatedWidth() };
+
+    if (std::isnan(width))
+        return false;
+
+    bool changed { false };
+
+    for (size_t i = 0; i < m_rows.size(); i++)
+    {
+        const size_t index { m_firstItem + i };
+
+        // The others keep the height of the last layout pass, already stored by onSceneBegin()
+        if (!m_unmeasuredRows.erase(m_rows[i].get()))
+            continue;
+
+        // Only the row subtree is calculated
+        m_rows[i]->layout().calculate(width, YGUndefined, m_slot.layout().calculatedDirection());
+        const SkScalar height { m_rows[i]->layout().calculatedHeight() };
+
+        if (std::isnan(height) || height == itemHeight(index))
+            continue;
+
+        if (index < anchor)
+            *anchorShift += height - itemHeight(index);
+
+        m_index.set(index, height);
+        changed = true;
+    }
+
+    return changed;
+}
+
+void AKListView::positionRows() noexcept
+{
+    for (size_t i = 0; i < m_rows.size(); i++)
+        m_rows[i]->layout().setPosition(YGEdgeTop, itemOffset(m_firstItem + i));
+}
+
+void AKListView::recycleRows() noexcept
+{
+    for (size_t i = 0; i < m_rows.size(); i++)
+        recycleRow(std::move(m_rows[i]), m_firstItem + i);
+
+    m_rows.clear();
+}
+
+std::unique_ptr<AKNode> AKListView::takeRow(size_t index) noexcept
+{
+    std::unique_ptr<AKNode> row;
+
+    if (m_pool.empty())
+    {
+        row = m_delegate->createRow();
+
+        if (!row)
+            row = std::make_unique<AKContainer>();
+
+        row->layout().setPositionType(YGPositionTypeAbsolute);
+        row->layout().setPosition(YGEdgeLeft, 0.f);
+        row->layout().setWidthPercent(100.f);
+    }
+    else
+    {
+        row = std::move(m_pool.back());
+        m_pool.pop_back();
+    }
+
+    row->layout().setPosition(YGEdgeTop, itemOffset(index));
+    row->setParent(&m_slot);
+    m_delegate->bindRow(*row, index);
+    m_unmeasuredRows.insert(row.get());
+    return row;
+}
+
+void AKListView::recycleRow(std::unique_ptr<AKNode> row, size_t index) noexcept
+{
+    if (!row)
+        return;
+
+    if (m_delegate)
+        m_delegate->unbindRow(*row, index);
+
+    m_unmeasuredRows.erase(row.get());
+
+    row->setParent(nullptr);
+    m_pool.emplace_back(std::move(row));
+}
+
+void AKListView::updateExtent() noexcept
+{
+    m_extent.layout().setHeight(m_index.total());
+}
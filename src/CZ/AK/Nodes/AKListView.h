@@ -0,0 +1,191 @@
+#ifndef CZ_AKLISTVIEW_H
+#define CZ_AKLISTVIEW_H
+
+#include <CZ/AK/Nodes/AKScroll.h>
+#include <CZ/Core/CZTimer.h>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <deque>
+#include <unordered_set>
+
+/**
+ * @brief Virtualized vertical list.
+ * @ingroup AKNodes
+ *
+ * Displays a large number of items while keeping in the tree only the rows that are visible plus a few
+ * extra rows above and below (see setOverscan()). Rows are created and filled by a Delegate and recycled
+ * as they go out of view, so the cost of layout, rendering and scrolling doesn't depend on the item count.
+ *
+ * Rows can have different heights. Until a row is bound for the first time its height is estimated
+ * (see Delegate::estimatedRowHeight()). Rows are measured right after being bound, before the scene layout
+ * pass, so once the list has a width they are never presented at estimated offsets. Rows whose height changes
+ * on their own, e.g. when their content is updated without invalidateItem(), are moved on the next frame.
+ * Offsets are stored in a Fenwick tree, so finding the row at a given offset takes O(log n).
+ *
+ * Rows are positioned absolutely and span the full width of the list, their height is determined by their content.
+ */
+class CZ::AKListView : public AKScroll
+{
+public:
+    /**
+     * @brief Creates and fills the rows of an AKListView.
+     */
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /**
+         * @brief Creates a new row.
+         *
+         * Only called when there is no recycled row available.
+         */
+        virtual std::unique_ptr<AKNode> createRow() noexcept = 0;
+
+        /**
+         * @brief Fills a row with the data of an item.
+         *
+         * Rows are reused, so everything previously bound must be replaced.
+         */
+        virtual void bindRow(AKNode &row, size_t index) noexcept = 0;
+
+        /**
+         * @brief Called when a row goes out of view, before being recycled.
+         */
+        virtual void unbindRow(AKNode &row, size_t index) noexcept { (void)row; (void)index; }
+
+        /**
+         * @brief Height used for an item until its row is measured.
+         */
+        virtual SkScalar estimatedRowHeight(size_t index) noexcept { (void)index; return DefaultEstimatedRowHeight; }
+    };
+
+    static constexpr SkScalar DefaultEstimatedRowHeight { 32.f };
+
+    AKListView(AKNode *parent = nullptr) noexcept;
+    ~AKListView();
+
+    /**
+     * @brief Sets the delegate (not owned).
+     *
+     * Current rows are destroyed, as they may have been created by the previous delegate.
+     */
+    void setDelegate(Delegate *delegate) noexcept;
+    Delegate *delegate() const noexcept { return m_delegate; }
+
+    /**
+     * @brief Sets the number of items.
+     *
+     * All heights are reset to their estimates and the visible rows are bound again.
+     */
+    void setItemCount(size_t count) noexcept;
+    size_t itemCount() const noexcept { return m_index.size(); }
+
+    /**
+     * @brief Number of extra rows kept above and below the visible ones.
+     *
+     * Avoids binding rows right when they enter the viewport. Defaults to 4.
+     */
+    void setOverscan(UInt32 rows) noexcept;
+    UInt32 overscan() const noexcept { return m_overscan; }
+
+    /**
+     * @brief Binds an item again if its row is in the tree, e.g. after its data changed.
+     */
+    void invalidateItem(size_t index) noexcept;
+
+    /**
+     * @brief Binds all rows in the tree again.
+     */
+    void reload() noexcept;
+
+    /**
+     * @brief Scrolls so that the item is at the top of the list.
+     */
+    void scrollToItem(size_t index) noexcept;
+
+    /**
+     * @brief Vertical offset of an item relative to the top of the content.
+     */
+    SkScalar itemOffset(size_t index) const noexcept { return m_index.prefix(index); }
+
+    /**
+     * @brief Current height of an item, either estimated or measured.
+     */
+    SkScalar itemHeight(size_t index) const noexcept { return m_index.height(index); }
+
+    /**
+     * @brief Index of the item at the given offset relative to the top of the content.
+     *
+     * Clamped to [0, itemCount() - 1], 0 if empty.
+     */
+    size_t itemAt(SkScalar offset) const noexcept { return m_index.find(offset); }
+
+    /**
+     * @brief The row currently bound to an item, or nullptr if not in the tree.
+     */
+    AKNode *rowForItem(size_t index) const noexcept;
+
+    /**
+     * @brief First item in the tree.
+     */
+    size_t firstRowItem() const noexcept { return m_firstItem; }
+
+    /**
+     * @brief Number of rows in the tree (visible plus overscan).
+     */
+    size_t rowCount() const noexcept { return m_rows.size(); }
+
+protected:
+    void onSceneBegin() override;
+    void onOffsetChanged() noexcept override;
+    void layoutEvent(const CZLayoutEvent &e) override;
+
+private:
+    // Fenwick tree of item heights
+    class HeightIndex
+    {
+    public:
+        void reset(size_t count, const std::function<SkScalar(size_t)> &estimate) noexcept;
+        void set(size_t index, SkScalar height) noexcept;
+        SkScalar height(size_t index) const noexcept { return index < m_heights.size() ? m_heights[index] : 0.f; }
+        SkScalar prefix(size_t count) const noexcept;
+        SkScalar total() const noexcept { return prefix(m_heights.size()); }
+        size_t find(SkScalar offset) const noexcept;
+        size_t size() const noexcept { return m_heights.size(); }
+    private:
+        std::vector<SkScalar> m_heights;
+        std::vector<double> m_tree; // 1-based
+    };
+
+    void updateRows() noexcept;
+    void updateRange() noexcept;
+    bool measureRows(size_t anchor, SkScalar *anchorShift) noexcept;
+    void positionRows() noexcept;
+    void recycleRows() noexcept;
+    std::unique_ptr<AKNode> takeRow(size_t index) noexcept;
+    void recycleRow(std::unique_ptr<AKNode> row, size_t index) noexcept;
+    void updateExtent() noexcept;
+
+    Delegate *m_delegate { nullptr };
+    HeightIndex m_index;
+
+    // Gives the slot the height of all items so that the content bounds and bars are correct
+    AKContainer m_extent { YGFlexDirectionColumn, false, &m_slot };
+
+    // Rows in the tree, m_rows[i] displays item m_firstItem + i
+    std::deque<std::unique_ptr<AKNode>> m_rows;
+    std::vector<std::unique_ptr<AKNode>> m_pool;
+    // Bound since the last measureRows() call
+    std::unordered_set<AKNode*> m_unmeasuredRows;
+    // Rows can't be added during AKScene::render(), updates requested meanwhile are deferred
+    CZTimer m_updateTimer;
+    size_t m_firstItem { 0 };
+    UInt32 m_overscan { 4 };
+    bool m_updatingRows { false };
+    // Set when measured heights changed the extent, the scroll bars are updated after the layout pass
+    bool m_extentChanged { false };
+};
+
+#endif // CZ_AKLISTVIEW_H
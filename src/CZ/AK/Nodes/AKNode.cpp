@@ -14,6 +14,7 @@
 #include <CZ/AK/AKTarget.h>
 #include <CZ/AK/AKScene.h>
 #include <CZ/AK/AKTheme.h>
+#include <CZ/AK/AKColorTheme.h>
 #include <CZ/AK/Nodes/AKNode.h>
 #include <CZ/AK/Nodes/AKSubScene.h>
 #include <CZ/AK/Nodes/AKContainer.h>
@@ -44,9 +45,23 @@ AKNode::~AKNode()
         m_children.back()->setParent(nullptr, false);
 
     setParent(nullptr, false);
+    setAssetPending(false);
     notifyDestruction();
 }
 
+void AKNode::setAssetPending(bool pending) noexcept
+{
+    if (pending == assetPending() || !m_app)
+        return;
+
+    m_flags.setFlag(AssetPending, pending);
+
+    if (pending)
+        m_app->m_assetPendingNodes.insert(this);
+    else
+        m_app->m_assetPendingNodes.erase(this);
+}
+
 bool AKNode::damageTargets() noexcept
 {
     if (!visible())
@@ -92,12 +107,31 @@ void AKNode::repaint() noexcept
         t->markDirty();
 }
 
+void AKNode::setRenderOffset(SkPoint offset) noexcept
+{
+    if (m_renderOffset == offset)
+        return;
+
+    m_renderOffset = offset;
+    m_flags.add(RenderOffsetChanged);
+
+    propagateNeedsApply();
+    repaint();
+}
+
+void AKNode::propagateNeedsApply() noexcept
+{
+    for (AKNode *parent = m_parent; parent && !parent->m_flags.has(DescendantNeedsApply); parent = parent->m_parent)
+        parent->m_flags.add(DescendantNeedsApply);
+}
+
 void AKNode::setVisible(bool visible) noexcept
 {
     if (visible == this->visible())
         return;
 
     layout().setDisplay(visible ? YGDisplayFlex : YGDisplayNone);
+    invalidateContentBounds();
 
     if (!visible)
         damageTargetsAndPropagate();
@@ -207,7 +241,10 @@ void AKNode::setParentPrivate(AKNode *parent, bool handleChanges, bool ignoreSlo
             if (handleChanges && m_parent != parent)
                 addChange(CHParent);
 
-            YGNodeRemoveChild(m_parent->layout().m_node, layout().m_node);
+            if (m_parent != parent)
+                invalidateContentBounds();
+
+            YGNodeRemoveChild(m_parent->layout().childrenNode(), layout().m_node);
         }
         auto next = m_parent->m_children.erase(m_parent->m_children.begin() + m_parentLink);
         for (; next != m_parent->m_children.end(); next++) (*next)->m_parentLink--;
@@ -227,7 +264,7 @@ void AKNode::setParentPrivate(AKNode *parent, bool handleChanges, bool ignoreSlo
             return;
         }
 
-        YGNodeInsertChild(parent->layout().m_node, layout().m_node, m_parentLink);
+        YGNodeInsertChild(parent->layout().childrenNode(), layout().m_node, m_parentLink);
 
         if (handleChanges)
         {
@@ -360,7 +397,7 @@ void AKNode::insertBefore(AKNode *other) noexcept
             m_parentLink = other->m_parentLink;
 
             if (!isBackgroundEffect)
-                YGNodeInsertChild(m_parent->layout().m_node, layout().m_node, m_parentLink);
+                YGNodeInsertChild(m_parent->layout().childrenNode(), layout().m_node, m_parentLink);
             auto next = m_parent->m_children.insert(m_parent->m_children.begin() + m_parentLink, this) + 1;
             for (; next != m_parent->m_children.end(); next++) (*next)->m_parentLink++;
 
@@ -434,7 +471,7 @@ void AKNode::insertAfter(AKNode *other) noexcept
             m_parentLink = other->m_parentLink + 1;
 
             if (!isBackgroundEffect)
-                YGNodeInsertChild(m_parent->layout().m_node, layout().m_node, m_parentLink);
+                YGNodeInsertChild(m_parent->layout().childrenNode(), layout().m_node, m_parentLink);
 
             auto next = m_parent->m_children.insert(m_parent->m_children.begin() + m_parentLink, this) + 1;
             for (; next != m_parent->m_children.end(); next++) (*next)->m_parentLink++;
@@ -464,6 +501,7 @@ void AKNode::setColorScheme(CZColorScheme scheme) noexcept
 
     m_colorScheme = scheme;
     addChange(CHColorScheme);
+    applyColorBindings();
 }
 
 void AKNode::setColorTheme(std::shared_ptr<AKColorTheme> theme) noexcept
@@ -473,6 +511,145 @@ void AKNode::setColorTheme(std::shared_ptr<AKColorTheme> theme) noexcept
 
     m_colorTheme = theme;
     addChange(CHColorTheme);
+    applyColorBindings();
+}
+
+UInt32 AKNode::propagateColorScheme(CZColorScheme scheme) noexcept
+{
+    if (scheme == CZColorScheme::Unknown)
+        scheme = CZColorScheme::Light;
+
+    return propagateColors(scheme, nullptr);
+}
+
+UInt32 AKNode::propagateColorTheme(std::shared_ptr<AKColorTheme> theme) noexcept
+{
+    if (!theme)
+        return 0;
+
+    return propagateColors(std::nullopt, theme);
+}
+
+UInt32 AKNode::propagateColors(const std::optional<CZColorScheme> &scheme, const std::shared_ptr<AKColorTheme> &theme) noexcept
+{
+    bool changed { false };
+
+    if (scheme && m_colorScheme != *scheme)
+    {
+        m_colorScheme = *scheme;
+        addChange(CHColorScheme);
+        changed = true;
+    }
+
+    if (theme && m_colorTheme != theme)
+    {
+        m_colorTheme = theme;
+        addChange(CHColorTheme);
+        changed = true;
+    }
+
+    UInt32 count { changed && applyColorBindings() ? 1u : 0u };
+
+    for (AKNode *child : m_children)
+        count += child->propagateColors(scheme, theme);
+
+    return count;
+}
+
+void AKNode::bindColor(AKColorRole role, std::function<void (SkColor)> setter) noexcept
+{
+    if (!setter)
+        return;
+
+    const SkColor color { m_colorTheme ? m_colorTheme->color(role, m_colorScheme) : SK_ColorBLACK };
+    setter(color);
+    m_colorBindings.emplace_back(role, color, std::move(setter));
+}
+
+bool AKNode::applyColorBindings() noexcept
+{
+    if (!m_colorTheme)
+        return false;
+
+    bool changed { false };
+
+    for (auto &binding : m_colorBindings)
+    {
+        const SkColor color { m_colorTheme->color(binding.role, m_colorScheme) };
+
+        if (color == binding.color)
+            continue;
+
+        binding.color = color;
+        binding.setter(color);
+        changed = true;
+    }
+
+    return changed;
+}
+
+AKNode *AKNode::contentBoundsTracker() const noexcept
+{
+    for (AKNode *parent = m_parent; parent; parent = parent->m_parent)
+    {
+        if (parent->m_contentBounds)
+            return parent;
+
+        // Descendants of clipping nodes don't extend the bounds
+        if (parent->childrenClippingEnabled())
+            return nullptr;
+    }
+
+    return nullptr;
+}
+
+void AKNode::invalidateContentBounds() noexcept
+{
+    if (AKNode *tracker = contentBoundsTracker())
+        tracker->m_contentBounds->dirty = true;
+}
+
+void AKNode::updateContentBounds(const SkIRect &prevLayoutRect) noexcept
+{
+    AKNode *tracker { contentBoundsTracker() };
+
+    if (!tracker || tracker->m_contentBounds->dirty)
+        return;
+
+    // Anchored nodes also move with their anchor, which doesn't trigger updates
+    if (layout().anchorNode())
+    {
+        tracker->m_contentBounds->dirty = true;
+        return;
+    }
+
+    // Parents are already applied, so their world rects are up to date
+    const SkIPoint offset { m_parent->worldRect().topLeft() - tracker->worldRect().topLeft() };
+    const SkIRect prevRect { prevLayoutRect.makeOffset(offset) };
+    SkIRect &bounds { tracker->m_contentBounds->rect };
+
+    // The previous rect didn't touch any edge, so the bounds can only grow
+    const bool prevInside {
+        prevRect.fLeft > bounds.fLeft && prevRect.fTop > bounds.fTop &&
+        prevRect.fRight < bounds.fRight && prevRect.fBottom < bounds.fBottom };
+
+    // Moving also moves the descendants, which are not updated since their layout rect stays the same
+    const bool movesDescendants {
+        prevLayoutRect.topLeft() != m_layoutRect.topLeft() &&
+        !childrenClippingEnabled() &&
+        !m_children.empty() };
+
+    if (!prevInside || movesDescendants)
+    {
+        tracker->m_contentBounds->dirty = true;
+        return;
+    }
+
+    const SkIRect rect { m_layoutRect.makeOffset(offset) };
+    bounds.fLeft = std::min(bounds.fLeft, rect.fLeft);
+    bounds.fTop = std::min(bounds.fTop, rect.fTop);
+    bounds.fRight = std::max(bounds.fRight, rect.fRight);
+    bounds.fBottom = std::max(bounds.fBottom, rect.fBottom);
 }
 
 void AKNode::enableChildrenClipping(bool enable) noexcept
@@ -482,6 +659,7 @@ void AKNode::enableChildrenClipping(bool enable) noexcept
 
     m_flags.setFlag(ChildrenClipping, enable);
     addChange(CHChildrenClipping);
+    invalidateContentBounds();
 }
 
 
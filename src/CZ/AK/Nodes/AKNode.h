@@ -5,6 +5,7 @@
 #include <CZ/AK/AKObject.h>
 #include <CZ/AK/AKLayout.h>
 #include <CZ/AK/AKChanges.h>
+#include <CZ/AK/AKColorRole.h>
 
 #include <CZ/Core/CZWeak.h>
 #include <CZ/Core/CZBitset.h>
@@ -16,6 +17,7 @@
 #include <CZ/skia/core/SkRegion.h>
 
 #include <unordered_set>
+#include <functional>
 #include <unordered_map>
 #include <memory>
 #include <vector>
@@ -280,6 +282,32 @@ public:
     std::shared_ptr<AKColorTheme> colorTheme() const noexcept { return m_colorTheme; }
     void setColorTheme(std::shared_ptr<AKColorTheme> theme) noexcept;
 
+    /**
+     * @brief Sets the color scheme of this node and all its descendants.
+     *
+     * Only the colors bound with bindColor() are updated, layout properties are never touched.
+     *
+     * @return Number of nodes whose bound colors actually changed.
+     */
+    UInt32 propagateColorScheme(CZColorScheme scheme) noexcept;
+
+    /**
+     * @brief Sets the color theme of this node and all its descendants.
+     *
+     * @see propagateColorScheme()
+     * @return Number of nodes whose bound colors actually changed.
+     */
+    UInt32 propagateColorTheme(std::shared_ptr<AKColorTheme> theme) noexcept;
+
+    /**
+     * @brief Binds a color property to a role of the node's color theme.
+     *
+     * The setter is called immediately with the current color, and then only when a scheme or theme change
+     * resolves the role to a different color. The setter must not add or clear bindings.
+     */
+    void bindColor(AKColorRole role, std::function<void(SkColor)> setter) noexcept;
+    void clearColorBindings() noexcept { m_colorBindings.clear(); }
+
     AKNode *parent() const noexcept { return m_parent; }
     AKNode *topmostParent() const noexcept;
     AKNode *bottommostRightChild() const noexcept;
@@ -317,6 +345,18 @@ public:
     SkIRect sceneRect() const noexcept { return m_sceneRect; }
     Int32 scale() const noexcept { return m_scale; }
 
+    /**
+     * @brief Offset added to the position calculated by the layout.
+     *
+     * Moves the node and its descendants without recalculating the layout, only their world rects
+     * are updated during the next AKScene::render(). Intended for scrolling, transitions and other
+     * per-frame animations of large subtrees. The layout of other nodes is not affected.
+     *
+     * For per-frame opacity changes see AKRenderable::setOpacity(), which doesn't affect the layout either.
+     */
+    void setRenderOffset(SkPoint offset) noexcept;
+    SkPoint renderOffset() const noexcept { return m_renderOffset; }
+
     /**
      * @brief Checks whether AKPointer::pos() is currently within worldRect().
      *
@@ -477,6 +517,19 @@ protected:
     virtual void keyboardKeyEvent(const CZKeyboardKeyEvent &event);
     virtual void keyboardLeaveEvent(const CZKeyboardLeaveEvent &event);
     virtual void sceneChangedEvent(const AKSceneChangedEvent &event);
+
+    /**
+     * @brief Marks the node as waiting for an asynchronously generated theme asset.
+     *
+     * Nodes should call it after each theme asset request, with true if the factory returned nullptr,
+     * and keep their previous asset meanwhile.
+     * While pending, assetsReadyEvent() is triggered when assets are ready or the theme is replaced.
+     */
+    void setAssetPending(bool pending) noexcept;
+    bool assetPending() const noexcept { return m_flags.has(AssetPending); }
+
+    /* Triggered while assetPending(), the node should request its theme assets again */
+    virtual void assetsReadyEvent() {}
 private:
     friend class AKBackgroundEffect;
     friend class AKRenderable;
@@ -486,6 +539,7 @@ private:
     friend class AKTarget;
     friend class AKScene;
     friend class AKLayout;
+    friend class AKScroll;
 
     enum Flags : UInt32
     {
@@ -498,7 +552,10 @@ private:
         ChildrenNeedPosUpdate       = 1 << 9,
         ChildrenNeedScaleUpdate     = 1 << 10,
         Skip                        = 1 << 11,
-        KeyboardFocusable           = 1 << 12
+        KeyboardFocusable           = 1 << 12,
+        RenderOffsetChanged         = 1 << 13,
+        DescendantNeedsApply        = 1 << 14,  // A descendant changed its render offset or its relayout boundary is dirty
+        AssetPending                = 1 << 15   // Registered in AKApp::m_assetPendingNodes
     };
 
     /* Created by AKScene when the node is presented on the target for the first time */
@@ -540,6 +597,30 @@ private:
     bool damageTargets() noexcept;
     void damageTargetsAndPropagate() noexcept;
     AKNode *topmostInvisibleParent() const noexcept;
+    bool applyColorBindings() noexcept;
+    UInt32 propagateColors(const std::optional<CZColorScheme> &scheme, const std::shared_ptr<AKColorTheme> &theme) noexcept;
+    AKNode *contentBoundsTracker() const noexcept;
+    void invalidateContentBounds() noexcept;
+    void updateContentBounds(const SkIRect &prevLayoutRect) noexcept;
+
+    // Lets AKLayout::applyTree() reach this node even if the layout of its ancestors didn't change
+    void propagateNeedsApply() noexcept;
+
+    struct ColorBinding
+    {
+        AKColorRole role;
+        SkColor color;
+        std::function<void(SkColor)> setter;
+    };
+
+    // Bounds of the visible descendants (not clipped by a descendant), relative to the node
+    struct ContentBounds
+    {
+        SkIRect rect {};
+
+        // Set when a change could shrink the rect, which then must be recalculated
+        bool dirty { true };
+    };
 
     // To keep the app alive
     std::shared_ptr<AKApp> m_app;
@@ -548,6 +629,7 @@ private:
     CZBitset<Flags> m_flags {};
     CZColorScheme m_colorScheme { CZColorScheme::Light };
     std::shared_ptr<AKColorTheme> m_colorTheme;
+    std::vector<ColorBinding> m_colorBindings;
 
     // Set by the parent AKScene or AKSubScene during AKScene::render() (just to prevent frequent m_targets lookups)
     CZWeak<TargetData> tData;
@@ -565,6 +647,15 @@ private:
     // Rect in world coordinates
     SkIRect m_worldRect {};
 
+    // See setRenderOffset()
+    SkPoint m_renderOffset { 0.f, 0.f };
+
+    // Rect relative to the parent (or anchor node) set by the last AKLayout::applyTree() call
+    SkIRect m_layoutRect {};
+
+    // Only set by nodes that track the bounds of their descendants (e.g. the AKScroll slot)
+    std::unique_ptr<ContentBounds> m_contentBounds;
+
     // Relative to the closest parent AKSubScene viewport, otherwise the AKScene viewport
     SkIRect m_sceneRect {};
 
@@ -56,11 +56,17 @@ void AKRoundSolidColor::onSceneBegin()
     if (ch.testAnyOf(CHStrokeColor, CHStrokeWidth))
         enableReplaceImageColor(m_strokeWidth == 0 || SkColorGetA(m_strokeColor) == 0);
 
-    if (ch.testAnyOf(CHBorderRadius, CHLayoutScale, CHStrokeColor, CHStrokeWidth, CHBackgroundColor))
+    if (assetPending() || ch.testAnyOf(CHBorderRadius, CHLayoutScale, CHStrokeColor, CHStrokeWidth, CHBackgroundColor))
     {
-        m_asset = theme()->RRect9Patch.get(borderRadius(), scale(), backgroundColor(), strokeWidth(), strokeColor());
-        setImage(m_asset->image);
-        setCenter(m_asset->center);
+        auto asset { theme()->roundRect9Patch(borderRadius(), scale(), backgroundColor(), strokeWidth(), strokeColor()) };
+        setAssetPending(!asset);
+
+        if (asset)
+        {
+            m_asset = asset;
+            setImage(m_asset->image);
+            setCenter(m_asset->center);
+        }
     }
 
     AKNinePatch::onSceneBegin();
@@ -85,3 +91,8 @@ void AKRoundSolidColor::onSceneBegin()
             opaqueRegion.setEmpty();
     }
 }
+
+void AKRoundSolidColor::assetsReadyEvent()
+{
+    repaint();
+}
@@ -32,6 +32,7 @@ public:
 
 protected:
     void onSceneBegin() override;
+    void assetsReadyEvent() override;
     using AKNinePatch::setCenter;
     using AKNinePatch::setImage;
     using AKRenderable::setColor;
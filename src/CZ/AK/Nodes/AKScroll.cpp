@@ -15,6 +15,7 @@ AKScroll::AKScroll(AKNode *parent) noexcept :
 {
 
     setSlot(&m_slot);
+    m_slot.m_contentBounds = std::make_unique<ContentBounds>();
     layout().setFlexGrow(1.f);
     layout().setOverflow(YGOverflowScroll);
     m_slot.layout().setOverflow(YGOverflowScroll);
@@ -24,20 +25,20 @@ AKScroll::AKScroll(AKNode *parent) noexcept :
     m_slot.layout().setWidthPercent(100.f);
     m_slot.layout().setHeightPercent(100.f);
 
-    m_kineticYAnim.setOnUpdateCallback([this](CZAnimation *a){
+    m_kineticYAnim.setOnUpdateCallback([this](AKAnimation *a){
         if (!m_fingersDownY)
         {
             if (-offsetY() - m_vel.fY < m_contentBounds.fTop)
             {
                 m_vel.fY *= std::exp(-5.f * a->value());
-                m_slot.layout().setPosition(YGEdgeTop,
-                    offsetY() * (1.f - a->value()) + m_contentBounds.fTop * a->value());
+                m_slot.setRenderOffset({ offsetX(),
+                    offsetY() * (1.f - a->value()) + m_contentBounds.fTop * a->value() });
             }
             if (-offsetY() - m_vel.fY + layout().calculatedHeight() > m_contentBounds.fBottom)
             {
                 m_vel.fY *= std::exp(-5.f * a->value());
-                m_slot.layout().setPosition(YGEdgeTop,
-                    offsetY() * (1.f - a->value()) + (-m_contentBounds.fBottom + layout().calculatedHeight()) * a->value());
+                m_slot.setRenderOffset({ offsetX(),
+                    offsetY() * (1.f - a->value()) + (-m_contentBounds.fBottom + layout().calculatedHeight()) * a->value() });
             }
             else
             {
@@ -52,26 +53,26 @@ AKScroll::AKScroll(AKNode *parent) noexcept :
         }
     });
 
-    m_kineticYAnim.setOnFinishCallback([this](CZAnimation *){
+    m_kineticYAnim.setOnFinishCallback([this](AKAnimation *){
         m_vel.fY = 0.f;
         moveYPrivate(m_vel.fY);
         repaint();
     });
 
-    m_kineticXAnim.setOnUpdateCallback([this](CZAnimation *a){
+    m_kineticXAnim.setOnUpdateCallback([this](AKAnimation *a){
         if (!m_fingersDownX)
         {                         
             if (-offsetX() < m_contentBounds.fLeft)
             {
                 m_vel.fX *= std::exp(-5.f * a->value());
-                m_slot.layout().setPosition(YGEdgeLeft,
-                                            offsetX() * (1.f - a->value()) + m_contentBounds.fLeft * a->value());
+                m_slot.setRenderOffset({ offsetX() * (1.f - a->value()) + m_contentBounds.fLeft * a->value(),
+                                         offsetY() });
             }
             if (-offsetX() + layout().calculatedWidth() > m_contentBounds.fRight)
             {
                 m_vel.fX *= std::exp(-5.f * a->value());
-                m_slot.layout().setPosition(YGEdgeLeft,
-                                            offsetX() * (1.f - a->value()) + (-m_contentBounds.fRight + layout().calculatedWidth()) * a->value());
+                m_slot.setRenderOffset({ offsetX() * (1.f - a->value()) + (-m_contentBounds.fRight + layout().calculatedWidth()) * a->value(),
+                                         offsetY() });
             }
             else
             {
@@ -86,7 +87,7 @@ AKScroll::AKScroll(AKNode *parent) noexcept :
         }
     });
 
-    m_kineticXAnim.setOnFinishCallback([this](CZAnimation *){
+    m_kineticXAnim.setOnFinishCallback([this](AKAnimation *){
         m_vel.fX = 0.f;
         moveXPrivate(m_vel.fX);
         repaint();
@@ -95,30 +96,29 @@ AKScroll::AKScroll(AKNode *parent) noexcept :
 
 SkScalar AKScroll::offsetX() const noexcept
 {
-    return m_slot.layout().position(YGEdgeLeft).value;
+    return m_slot.renderOffset().x();
 }
 
 SkScalar AKScroll::offsetY() const noexcept
 {
-    return m_slot.layout().position(YGEdgeTop).value;
+    return m_slot.renderOffset().y();
 }
 
 void AKScroll::setOffset(SkScalar x, SkScalar y) noexcept
 {
-    m_slot.layout().setPosition(YGEdgeTop, y);
-    m_slot.layout().setPosition(YGEdgeLeft, x);
+    m_slot.setRenderOffset({ x, y });
     applyConstraints();
 }
 
 void AKScroll::setOffsetX(Int32 x) noexcept
 {
-    m_slot.layout().setPosition(YGEdgeLeft, x);
+    m_slot.setRenderOffset({ SkScalar(x), offsetY() });
     applyConstraints();
 }
 
 void AKScroll::setOffsetY(Int32 y) noexcept
 {
-    m_slot.layout().setPosition(YGEdgeTop, y);
+    m_slot.setRenderOffset({ offsetX(), SkScalar(y) });
     applyConstraints();
 }
 
@@ -136,39 +136,55 @@ void AKScroll::setOffsetYPercent(SkScalar y) noexcept
     setOffsetY(-m_contentBounds.height() * y + SkScalar(m_contentBounds.fTop));
 }
 
-static void contentBounds(AKNode *root, SkIRect *bounds) noexcept
+void AKScroll::onSceneBegin()
 {
-    if (!root->visible())
-        return;
+    AKContainer::onSceneBegin();
 
-    if (root->layout().calculatedLeft() < bounds->fLeft)
-        bounds->fLeft = root->layout().calculatedLeft();
+    // Sub scenes render with their own scene
+    if (m_scrollBlit && scene() && !subScene())
+        scene()->addScrollBlit(this, &m_slot);
+}
 
-    if (root->layout().calculatedTop() < bounds->fTop)
-        bounds->fTop = root->layout().calculatedTop();
+// Same rects AKLayout::applyTree() assigns, relative to the slot
+static void contentBounds(AKNode *root, SkIPoint offset, SkIRect *bounds) noexcept
+{
+    if (!root->visible())
+        return;
 
-    const Int32 right = root->layout().calculatedLeft() + root->layout().calculatedWidth();
-    if (right > bounds->fRight)
-        bounds->fRight = right;
+    const SkIRect rect { SkIRect::MakeXYWH(
+        offset.x() + SkScalarFloorToInt(root->layout().calculatedLeft() + root->renderOffset().x()),
+        offset.y() + SkScalarFloorToInt(root->layout().calculatedTop() + root->renderOffset().y()),
+        SkScalarRoundToInt(root->layout().calculatedWidth()),
+        SkScalarRoundToInt(root->layout().calculatedHeight())) };
 
-    const Int32 bottom = root->layout().calculatedTop() + root->layout().calculatedHeight();
-    if (bottom > bounds->fBottom)
-        bounds->fBottom = bottom;
+    bounds->fLeft = std::min(bounds->fLeft, rect.fLeft);
+    bounds->fTop = std::min(bounds->fTop, rect.fTop);
+    bounds->fRight = std::max(bounds->fRight, rect.fRight);
+    bounds->fBottom = std::max(bounds->fBottom, rect.fBottom);
 
     if (root->childrenClippingEnabled())
         return;
 
-    for (AKNode *child : root->children())
-        contentBounds(child, bounds);
+    for (AKNode *child : root->children(true))
+        contentBounds(child, rect.topLeft(), bounds);
 }
 
 void AKScroll::calculateContentBounds() noexcept
 {
-    m_contentBounds.setEmpty();
+    // Kept up to date by AKLayout::applyTree(), only recalculated when a change could shrink it
+    ContentBounds &tracked { *m_slot.m_contentBounds };
 
-    for (AKNode *child : m_slot.children())
-        contentBounds(child, &m_contentBounds);
+    if (tracked.dirty)
+    {
+        tracked.rect.setEmpty();
+
+        for (AKNode *child : m_slot.children(true))
+            contentBounds(child, { 0, 0 }, &tracked.rect);
 
+        tracked.dirty = false;
+    }
+
+    m_contentBounds = tracked.rect;
     m_contentBounds.fRight += m_slot.layout().calculatedPadding(YGEdgeRight);
     m_contentBounds.fBottom += m_slot.layout().calculatedPadding(YGEdgeBottom);
 
@@ -194,10 +210,10 @@ void AKScroll::applyConstraints() noexcept
     else if (m_contentBounds.fBottom + y < layout().calculatedHeight())
         y = -(m_contentBounds.fBottom - layout().calculatedHeight());
 
-    m_slot.layout().setPosition(YGEdgeTop, y);
-    m_slot.layout().setPosition(YGEdgeLeft, x);
+    m_slot.setRenderOffset({ x, y });
     updateBarXPrivate();
     updateBarYPrivate();
+    onOffsetChanged();
 }
 
 void AKScroll::pointerScrollEvent(const CZPointerScrollEvent &e)
@@ -362,6 +378,9 @@ void AKScroll::layoutEvent(const CZLayoutEvent &e)
     if (!e.changes.has(CZLayoutChangeSize)) return;
 
     m_vel.set(0.f, 0.f);
+
+    // The descendants are applied after this event, so use their new Yoga layout instead
+    m_slot.m_contentBounds->dirty = true;
     calculateContentBounds();
     applyConstraints();
     layout().calculate();
@@ -441,12 +460,14 @@ void AKScroll::updateBarYPrivate() noexcept
 
 void AKScroll::moveXPrivate(SkScalar dx) noexcept
 {
-    m_slot.layout().setPosition(YGEdgeLeft, offsetX() + dx);
+    m_slot.setRenderOffset({ offsetX() + dx, offsetY() });
     updateBarXPrivate();
+    onOffsetChanged();
 }
 
 void AKScroll::moveYPrivate(SkScalar dy) noexcept
 {
-    m_slot.layout().setPosition(YGEdgeTop, offsetY() + dy);
+    m_slot.setRenderOffset({ offsetX(), offsetY() + dy });
     updateBarYPrivate();
+    onOffsetChanged();
 }
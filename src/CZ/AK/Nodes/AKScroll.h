@@ -3,7 +3,7 @@
 
 #include <CZ/AK/Nodes/AKContainer.h>
 #include <CZ/AK/Nodes/AKScrollBar.h>
-#include <CZ/Core/CZLinearAnimation.h>
+#include <CZ/AK/AKAnimation.h>
 
 class CZ::AKScroll : public AKContainer
 {
@@ -30,7 +30,29 @@ public:
         return m_vBar;
     }
 
+    /**
+     * @brief Reuses the already rendered content when scrolling.
+     *
+     * When enabled, the scene shifts the pixels of the previous frame within the visible area by the
+     * scroll delta and only repaints the newly exposed strip, instead of repainting the whole area on each step.
+     * Content that changed meanwhile and nodes overlapping the area (e.g. the scroll bars) are still repainted.
+     *
+     * Nodes behind the content (parents and nodes below) are assumed to look the same when shifted, e.g. a solid
+     * color background. Don't enable it if the content is translucent over a gradient, image, etc.
+     *
+     * Only used when the target buffer age is 1, its transform is normal and the delta maps to whole pixels,
+     * otherwise the area is repainted as usual. Disabled by default.
+     */
+    void setScrollBlitEnabled(bool enabled) noexcept { m_scrollBlit = enabled; }
+    bool scrollBlitEnabled() const noexcept { return m_scrollBlit; }
+
 protected:
+    void onSceneBegin() override;
+
+    /**
+     * @brief Called each time the scroll offset changes.
+     */
+    virtual void onOffsetChanged() noexcept {}
     void calculateContentBounds() noexcept;
     void applyConstraints() noexcept;
     void pointerScrollEvent(const CZPointerScrollEvent &e) override;
@@ -44,8 +66,8 @@ protected:
     void moveYPrivate(SkScalar dy) noexcept;
 
     AKContainer m_slot;
-    CZLinearAnimation m_kineticYAnim;
-    CZLinearAnimation m_kineticXAnim;
+    AKAnimation m_kineticYAnim { *this };
+    AKAnimation m_kineticXAnim { *this };
     SkPoint m_vel { 0.f, 0.f };
     SkIRect m_contentBounds { 0, 0, 0, 0};
     Int64 m_lastFingerTimeX;
@@ -54,6 +76,7 @@ protected:
     AKScrollBar m_vBar { this, CZEdgeRight, this };
     bool m_fingersDownX { false };
     bool m_fingersDownY { false };
+    bool m_scrollBlit { false };
 };
 
 #endif // CZ_AKSCROLL_H
@@ -23,14 +23,14 @@ AKScrollBar::AKScrollBar(AKScroll *scroll, CZEdge edge, AKNode *parent) noexcept
     setEdge(edge);
 
     m_fadeOutAnim.setDuration(300);
-    m_fadeOutAnim.setOnUpdateCallback([this](CZAnimation *a){
+    m_fadeOutAnim.setOnUpdateCallback([this](AKAnimation *a){
 
         if (opacity() > 0.f)
             setOpacity(1.0 - a->value());
         m_handle.setOpacity(0.5 * (1.0 - a->value()));
     });
 
-    m_fadeOutAnim.setOnFinishCallback([this](CZAnimation *){
+    m_fadeOutAnim.setOnFinishCallback([this](AKAnimation *){
 
         if (m_preventHide)
             return;
@@ -58,7 +58,7 @@ AKScrollBar::AKScrollBar(AKScroll *scroll, CZEdge edge, AKNode *parent) noexcept
     });
 
     m_hoverAnim.setDuration(100);
-    m_hoverAnim.setOnUpdateCallback([this](CZAnimation *a){
+    m_hoverAnim.setOnUpdateCallback([this](AKAnimation *a){
         setOpacity(a->value());
 
         if (m_handle.orientation() == CZOrientation::H)
@@ -69,7 +69,7 @@ AKScrollBar::AKScrollBar(AKScroll *scroll, CZEdge edge, AKNode *parent) noexcept
                 (AKTheme::ScrollBarHandleWidthHover - AKTheme::ScrollBarHandleWidth) * a->value());
     });
 
-    m_hoverAnim.setOnFinishCallback([this](CZAnimation *){
+    m_hoverAnim.setOnFinishCallback([this](AKAnimation *){
         setOpacity(1.f);
     });
 
@@ -319,8 +319,9 @@ void AKScrollBar::layoutEvent(const CZLayoutEvent &e)
 
 void AKScrollBar::updateImages() noexcept
 {
+    // Images are nullptr while generated asynchronously, the previous ones are kept meanwhile
     SkRect side, center;
-    m_handle.setImage(theme()->roundLineThreePatchImage(
+    auto handleImage { theme()->roundLineThreePatchImage(
         m_handle.orientation(),
         m_handle.orientation() == CZOrientation::H
             ?
@@ -328,20 +329,30 @@ void AKScrollBar::updateImages() noexcept
             :
             m_handle.layout().calculatedWidth(),
         scale(),
-        &side, &center));
+        &side, &center) };
 
-    m_handle.setSideSrcRect(side);
-    m_handle.setCenterSrcRect(center);
-    m_handle.setImageScale(scale());
+    if (handleImage)
+    {
+        m_handle.setImage(handleImage);
+        m_handle.setSideSrcRect(side);
+        m_handle.setCenterSrcRect(center);
+        m_handle.setImageScale(scale());
+    }
 
-    setImage(theme()->scrollRailThreePatchImage(
+    auto railImage { theme()->scrollRailThreePatchImage(
         orientation(),
         scale(),
-        &side, &center));
+        &side, &center) };
+
+    if (railImage)
+    {
+        setImage(railImage);
+        setSideSrcRect(side);
+        setCenterSrcRect(center);
+        setImageScale(scale());
+    }
 
-    setSideSrcRect(side);
-    setCenterSrcRect(center);
-    setImageScale(scale());
+    setAssetPending(!handleImage || !railImage);
 }
 
 void AKScrollBar::updateGeometry() noexcept
@@ -361,3 +372,8 @@ void AKScrollBar::updateGeometry() noexcept
         m_handle.layout().setHeight(AKTheme::ScrollBarHandleWidth);
     }
 }
+
+void AKScrollBar::assetsReadyEvent()
+{
+    updateImages();
+}
@@ -3,7 +3,7 @@
 
 #include <CZ/AK/Nodes/AKContainer.h>
 #include <CZ/AK/Nodes/AKThreePatch.h>
-#include <CZ/Core/CZLinearAnimation.h>
+#include <CZ/AK/AKAnimation.h>
 #include <CZ/Core/CZTimer.h>
 #include <CZ/Core/CZEdge.h>
 
@@ -44,6 +44,7 @@ protected:
     void pointerEnterEvent(const CZPointerEnterEvent &e) override;
     void pointerLeaveEvent(const CZPointerLeaveEvent &e) override;
     void layoutEvent(const CZLayoutEvent &e) override;
+    void assetsReadyEvent() override;
     void updateImages() noexcept;
     void updateGeometry() noexcept;
     SkScalar m_posPercent { 0.f };
@@ -52,8 +53,8 @@ protected:
     AKThreePatch m_handle { CZOrientation::H, this };
     CZEdge m_edge { CZEdgeNone };
     CZTimer m_fadeOutTimer;
-    CZLinearAnimation m_fadeOutAnim;
-    CZLinearAnimation m_hoverAnim;
+    AKAnimation m_fadeOutAnim { *this };
+    AKAnimation m_hoverAnim { *this };
     CZWeak<AKScroll> m_scroll;
     bool m_dragging { false };
     bool m_preventHide { false };
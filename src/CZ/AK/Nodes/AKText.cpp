@@ -1,4 +1,6 @@
 #include <CZ/skia/core/SkCanvas.h>
+#include <CZ/skia/core/SkPath.h>
+#include <CZ/skia/core/SkPictureRecorder.h>
 #include <CZ/AK/Nodes/AKText.h>
 #include <CZ/AK/Events/AKBakeEvent.h>
 #include <CZ/AK/AKTheme.h>
@@ -6,17 +8,28 @@
 #include <CZ/AK/AKApp.h>
 #include <CZ/Ream/RSurface.h>
 #include <CZ/Ream/RPass.h>
-#include <locale>
-#include <codecvt>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string_view>
 
 using namespace CZ;
 
-static void replaceAllInPlace(std::string &dst, const std::string &find, const std::string &replace) {
-    size_t pos { 0 };
-    while ((pos = dst.find(find, pos)) != std::string::npos) {
-        dst.replace(pos, 1, replace);
-        pos += replace.size();
-    }
+// Line bands span the entire node width, lines may have been wider or narrower before
+static SkIRect lineBandDamage(const SkIRect &lineRect) noexcept
+{
+    return SkIRect::MakeLTRB(AK_IRECT_INF.fLeft, lineRect.fTop - 1, AK_IRECT_INF.fRight, lineRect.fBottom + 1);
+}
+
+static SkScalar spaceWidth(const skia::textlayout::ParagraphStyle &paragraphStyle, const skia::textlayout::TextStyle &textStyle) noexcept
+{
+    auto builder { skia::textlayout::ParagraphBuilderImpl::make(paragraphStyle, AKApp::Get()->fontCollection()) };
+    builder->pushStyle(textStyle);
+    builder->addText(" ", 1);
+    builder->pop();
+    auto paragraph { builder->Build() };
+    paragraph->layout(3000000);
+    return paragraph->getMaxIntrinsicWidth();
 }
 
 AKText::AKText(const std::string &text, AKNode *parent) noexcept : AKBakeable(parent)
@@ -30,22 +43,71 @@ AKText::AKText(const std::string &text, AKNode *parent) noexcept : AKBakeable(pa
 
 bool AKText::setText(const std::string &text) noexcept
 {
-    if (m_text == text)
+    if (this->text() == text)
         return false;
 
+    const size_t oldSize { m_buffer.size() };
+    const bool selectionCleared { clearSelection(0, oldSize) };
+    m_buffer.assign(text);
     m_text = text;
-    m_skText = text;
-    replaceAllInPlace(m_skText, "\t", "    ");
-    updateCodePointByteOffsets();
-    const size_t prevSelectionB { m_selection[1] };
+    m_textValid = true;
+    m_skTextValid = m_codePointByteOffsetsValid = false;
+    onTextEdited(0, oldSize, m_buffer.size(), selectionCleared);
+    return true;
+}
+
+bool AKText::replaceText(size_t codePoint, size_t count, const std::string &utf8) noexcept
+{
+    codePoint = std::min(codePoint, codePointCount());
+    count = std::min(count, codePointCount() - codePoint);
+
+    if (count == 0 && utf8.empty())
+        return false;
+
+    const size_t begin { m_buffer.byteOffset(codePoint) };
+    const size_t oldEnd { m_buffer.byteOffset(codePoint + count) };
+    const bool selectionCleared { clearSelection(begin, oldEnd) };
+    m_buffer.erase(codePoint, count);
+    const size_t inserted { m_buffer.insert(codePoint, utf8) };
+    m_textValid = m_skTextValid = m_codePointByteOffsetsValid = false;
+    onTextEdited(begin, oldEnd, m_buffer.byteOffset(codePoint + inserted), selectionCleared);
+    return true;
+}
+
+bool AKText::clearSelection(size_t begin, size_t end) noexcept
+{
+    if (m_selection[1] == 0)
+        return false;
+
+    const size_t selA { codePointByteOffset(m_selection[0]) };
+    const size_t selB { codePointByteOffset(m_selection[0] + m_selection[1]) };
     m_selection[0] = m_selection[1] = 0;
+
+    if (m_blocks.empty())
+        return true;
+
+    // Blocks touched by the edit are rebuilt anyway
+    const size_t first { blockAt(selA) }, last { blockAt(selB) + 1 };
+    const size_t editFirst { blockAt(begin) }, editLast { blockAt(end) + 1 };
+
+    if (first < editFirst)
+        reshapeBlocks(first, std::min(last, editFirst));
+
+    if (last > editLast)
+        reshapeBlocks(std::max(first, editLast), last);
+
+    return true;
+}
+
+void AKText::onTextEdited(size_t begin, size_t oldEnd, size_t newEnd, bool selectionCleared) noexcept
+{
+    updateBlocks(begin, oldEnd, newEnd);
     addChange(CHText);
     updateDimensions();
     onTextChanged.notify();
 
-    if (prevSelectionB != m_selection[1])
+    if (selectionCleared)
         onSelectionChanged.notify();
-    return true;
 }
 
 bool AKText::setTextStyle(const skia::textlayout::TextStyle &textStyle) noexcept
@@ -61,8 +123,18 @@ bool AKText::setTextStyle(const skia::textlayout::TextStyle &textStyle) noexcept
     paint.setColor(SK_ColorWHITE);
     paint.setAntiAlias(true);
     m_selectedStyle.setForegroundColor(paint);
+
+    // Letter spacing is added to every glyph, including the tab's space
+    const SkScalar tabSpacing { 3.f * spaceWidth(m_paragraphStyle, m_textStyle) + 4.f * m_textStyle.getLetterSpacing() };
+    m_tabStyle = m_textStyle;
+    m_tabStyle.setLetterSpacing(tabSpacing);
+    m_selectedTabStyle = m_selectedStyle;
+    m_selectedTabStyle.setLetterSpacing(tabSpacing);
+
     addChange(CHTextStyle);
+    reshapeBlocks(0, m_blocks.size());
     updateDimensions();
+    addDamage(AK_IRECT_INF);
     return true;
 }
 
@@ -73,11 +145,24 @@ const skia::textlayout::TextStyle &AKText::textStyle() const noexcept
 
 const std::string &AKText::text() const noexcept
 {
+    if (!m_textValid)
+    {
+        m_text = m_buffer.str();
+        m_textValid = true;
+    }
+
     return m_text;
 }
 
 const std::string &AKText::skText() const noexcept
 {
+    if (!m_skTextValid)
+    {
+        m_skText = text();
+        std::replace(m_skText.begin(), m_skText.end(), '\t', ' ');
+        m_skTextValid = true;
+    }
+
     return m_skText;
 }
 
@@ -85,19 +170,44 @@ void AKText::setSelection(size_t start, size_t count) noexcept
 {
     //AKLog::debug("Selection %zu %zu", start, count);
 
-    if (m_codePointByteOffsets.empty() || start >= m_codePointByteOffsets.size())
+    const size_t codePoints { codePointCount() };
+
+    if (codePoints == 0 || start >= codePoints)
         start = count = 0;
 
-    if (start + count > m_codePointByteOffsets.size())
-        count = m_codePointByteOffsets.size() - start;
+    if (start + count > codePoints)
+        count = codePoints - start;
 
     if (m_selection[0] != start || m_selection[1] != count)
     {
+        const size_t prevA { codePointByteOffset(m_selection[0]) };
+        const size_t prevB { codePointByteOffset(m_selection[0] + m_selection[1]) };
+        const bool hadSelection { m_selection[1] != 0 };
         m_selection[0] = start;
         m_selection[1] = count;
-        updateParagraph();
+
+        // Only the blocks that were or are now selected are reshaped
+        if (!m_blocks.empty())
+        {
+            size_t first { m_blocks.size() }, last { 0 };
+
+            if (hadSelection)
+            {
+                first = blockAt(prevA);
+                last = blockAt(prevB) + 1;
+            }
+
+            if (count != 0)
+            {
+                first = std::min(first, blockAt(codePointByteOffset(start)));
+                last = std::max(last, blockAt(codePointByteOffset(start + count)) + 1);
+            }
+
+            if (first < last)
+                reshapeBlocks(first, last);
+        }
+
         addChange(CHSelection);
-        addDamage(AK_IRECT_INF);
         onSelectionChanged.notify();
     }
 }
@@ -107,162 +217,419 @@ const size_t *AKText::selection() const noexcept
     return m_selection;
 }
 
-int utf16ToCodePointIndex(const std::u16string& utf16Str, size_t utf16Index) {
-    int codePointIndex = 0;
+size_t AKText::codePointAt(SkScalar x, SkScalar y) const noexcept
+{
+    if (m_blocks.empty())
+        return 0;
 
-    for (size_t i = 0; i < utf16Index; ++i) {
-        char16_t c = utf16Str[i];
-        if (c >= 0xD800 && c <= 0xDBFF) {
-            // High-surrogate, skip the next code unit
-            ++i;
-        }
-        ++codePointIndex;
-    }
+    const Block &block { m_blocks[blockAtY(y)] };
+    const size_t utf16 { size_t(std::max(0, block.paragraph->getGlyphPositionAtCoordinate(x, y - block.top).position)) };
 
-    return codePointIndex;
-}
+    // Only the line is walked to convert the UTF-16 index into a byte offset
+    const auto [a, b] { m_buffer.segments(block.start, block.end) };
+    size_t byte { block.start }, units { 0 };
 
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#endif
+    for (const auto segment : { a, b })
+        for (const char c : segment)
+        {
+            if ((c & 0xC0) != 0x80)
+            {
+                if (units >= utf16)
+                    return m_buffer.codePointIndex(byte);
 
-size_t AKText::codePointAt(SkScalar x, SkScalar y) const noexcept
-{
-    if (!m_paragraph)
-        return 0;
+                // 4-byte sequences are surrogate pairs
+                units += UInt8(c) >= 0xF0 ? 2 : 1;
+            }
 
-    // TODO: Replace this (deprecated)
-    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> converter;
-    std::u16string utf16Str = converter.from_bytes(m_skText);
-    return utf16ToCodePointIndex(utf16Str, m_paragraph->getGlyphPositionAtCoordinate(x, y).position);
-}
+            byte++;
+        }
 
-#if defined(__GNUC__) || defined(__clang__)
-#pragma GCC diagnostic pop
-#endif
+    return m_buffer.codePointIndex(byte);
+}
 
 SkRect AKText::glyphAtCodePoint(size_t codePoint) const noexcept
 {
-    if (!m_paragraph)
+    if (m_blocks.empty())
         return {0.f, 0.f, 0.f, 0.f};
 
-    skia::textlayout::Paragraph::GlyphInfo info;
-    auto *par = (skia::textlayout::ParagraphImpl*)m_paragraph.get();
-    if (codePoint > 0 && codePoint >= codePointByteOffsets().size())
+    if (codePoint > 0 && codePoint >= codePointCount())
         codePoint--;
 
+    const size_t byte { codePointByteOffset(codePoint) };
+    const Block &block { m_blocks[blockAt(byte)] };
+
+    // A '\n' has no glyph, it sits at the end of its line
+    if (byte >= block.end)
+    {
+        const SkScalar x { block.paragraph->getMaxIntrinsicWidth() };
+        return SkRect::MakeLTRB(x, block.top, x, block.top + block.paragraph->getHeight());
+    }
+
+    skia::textlayout::Paragraph::GlyphInfo info;
+    auto *par = (skia::textlayout::ParagraphImpl*)block.paragraph.get();
+
+    // The UTF-16 mapping only covers this line
     par->ensureUTF16Mapping();
-    m_paragraph->getGlyphInfoAtUTF16Offset(par->getUTF16Index(codePointByteOffset(codePoint)), &info);
-    return info.fGraphemeLayoutBounds;
+    block.paragraph->getGlyphInfoAtUTF16Offset(par->getUTF16Index(byte - block.start), &info);
+    return info.fGraphemeLayoutBounds.makeOffset(0.f, block.top);
 }
 
 size_t AKText::codePointByteOffset(size_t codePoint) const noexcept
 {
-    if (codePoint >= m_codePointByteOffsets.size())
-        return m_skText.size();
-
-    return m_codePointByteOffsets[codePoint];
+    return m_buffer.byteOffset(codePoint);
 }
 
 const std::vector<size_t> &AKText::codePointByteOffsets() const noexcept
 {
+    if (!m_codePointByteOffsetsValid)
+    {
+        m_buffer.copyByteOffsets(m_codePointByteOffsets);
+        m_codePointByteOffsetsValid = true;
+    }
+
     return m_codePointByteOffsets;
 }
 
+size_t AKText::codePointCount() const noexcept
+{
+    return m_buffer.codePointCount();
+}
+
 void AKText::bakeEvent(const AKBakeEvent &e)
 {
-    if (e.damage.isEmpty() && !e.changes.testAnyOf(CHText, CHTextStyle, CHParagraphStyle, CHSelection))
+    const bool styleChanged { e.changes.testAnyOf(CHTextStyle, CHParagraphStyle) };
+
+    if (e.damage.isEmpty() && !styleChanged)
         return;
 
+    const SkIRect bounds { SkIRect::MakeSize(worldRect().size()) };
+
+    // Only the damaged line bands are repainted unless the entire surface is damaged
+    SkRegion repaint;
+
+    if (styleChanged || e.damage.contains(bounds))
+    {
+        repaint.setRect(bounds);
+        e.damage.op(bounds, SkRegion::kUnion_Op);
+    }
+    else
+    {
+        repaint.op(e.damage, bounds, SkRegion::kIntersect_Op);
+
+        if (repaint.isEmpty())
+            return;
+    }
+
     auto pass { e.surface->beginPass(RPassCap_SkCanvas) };
     auto *c { pass->getCanvas() };
 
     c->save();
-    c->clipIRect(SkIRect::MakeSize(worldRect().size()));
+
+    if (repaint.isRect())
+        c->clipIRect(repaint.getBounds());
+    else
+    {
+        // clipRegion() ignores the canvas matrix (scale), a path doesn't
+        SkPath clip;
+        repaint.getBoundaryPath(&clip);
+        c->clipPath(clip);
+    }
+
     c->clear(SK_ColorTRANSPARENT);
 
-    if (m_paragraph)
-        m_paragraph->paint(c, 0.f, 0.f);
+    if (!m_blocks.empty())
+    {
+        const SkIRect &clip { repaint.getBounds() };
+
+        // Glyphs may overhang the paragraph box, so the previous block is included too
+        size_t i { blockAtY(SkScalar(clip.fTop)) };
+
+        if (i > 0)
+            i--;
+
+        for (; i < m_blocks.size(); i++)
+        {
+            auto &block { m_blocks[i] };
+            const SkScalar h { block.paragraph->getHeight() };
+
+            if (block.top - h > SkScalar(clip.fBottom))
+                break;
+
+            if (!block.picture)
+            {
+                SkPictureRecorder recorder;
+                auto *rc { recorder.beginRecording(SkRect::MakeLTRB(-h, -h, block.paragraph->getMaxIntrinsicWidth() + h, 2.f * h)) };
+                block.paragraph->paint(rc, 0.f, 0.f);
+                block.picture = recorder.finishRecordingAsPicture();
+            }
+
+            const SkMatrix matrix { SkMatrix::Translate(0.f, block.top) };
+            c->drawPicture(block.picture, &matrix, nullptr);
+        }
+    }
 
     c->restore();
 }
 
 void AKText::updateDimensions() noexcept
 {
-    if (m_text.empty())
+    if (m_blocks.empty())
     {
         layout().setWidthAuto();
         layout().setHeightAuto();
         return;
     }
 
-    updateParagraph();
-    layout().setWidth(SkScalarRoundToScalar(m_paragraph->getMaxIntrinsicWidth()));
-    layout().setHeight(SkScalarRoundToScalar(m_paragraph->getHeight()));
-    addDamage(AK_IRECT_INF);
+    SkScalar width { 0.f };
+
+    for (const auto &block : m_blocks)
+        width = std::max(width, block.paragraph->getMaxIntrinsicWidth());
+
+    const auto &last { m_blocks.back() };
+    layout().setWidth(SkScalarRoundToScalar(width));
+    layout().setHeight(SkScalarRoundToScalar(last.top + last.paragraph->getHeight()));
 }
 
-void AKText::updateCodePointByteOffsets() noexcept
+void AKText::updateBlocks(size_t begin, size_t oldEnd, size_t newEnd) noexcept
 {
-    m_codePointByteOffsets.clear();
-    m_codePointByteOffsets.reserve(m_skText.size() * 4);
-    size_t offset { 0 };
-
-    for (size_t i = 0; i < m_skText.size(); ++i) {
-        m_codePointByteOffsets.push_back(offset);
-
-        if ((m_skText[i] & 0x80) == 0) { // 1-byte character (ASCII)
-            offset += 1;
-        } else if ((m_skText[i] & 0xE0) == 0xC0) { // 2-byte character
-            offset += 2;
-            i += 1; // Skip the continuation byte
-        } else if ((m_skText[i] & 0xF0) == 0xE0) { // 3-byte character
-            offset += 3;
-            i += 2; // Skip the continuation bytes
-        } else if ((m_skText[i] & 0xF8) == 0xF0) { // 4-byte character
-            offset += 4;
-            i += 3; // Skip the continuation bytes
+    if (m_buffer.empty())
+    {
+        for (const auto &block : m_blocks)
+            damageBlock(block);
+
+        m_blocks.clear();
+        return;
+    }
+
+    size_t first { 0 }, last { 0 }, start { 0 }, end { m_buffer.size() };
+
+    if (!m_blocks.empty())
+    {
+        first = blockAt(begin);
+        last = blockAt(oldEnd) + 1;
+        start = m_blocks[first].start;
+        end = m_blocks[last - 1].end - oldEnd + newEnd;
+
+        // Following blocks are only shifted
+        for (size_t i = last; i < m_blocks.size(); i++)
+        {
+            m_blocks[i].start = m_blocks[i].start - oldEnd + newEnd;
+            m_blocks[i].end = m_blocks[i].end - oldEnd + newEnd;
+        }
+    }
+
+    std::vector<Block> blocks;
+    const auto [a, b] { m_buffer.segments(start, end) };
+    size_t lineStart { start }, offset { start };
+
+    for (const auto segment : { a, b })
+    {
+        const char *data { segment.data() };
+        const char *dataEnd { data + segment.size() };
+        const char *newLine;
+
+        while ((newLine = (const char*)std::memchr(data, '\n', size_t(dataEnd - data))))
+        {
+            auto &block { blocks.emplace_back() };
+            block.start = lineStart;
+            block.end = offset + size_t(newLine - segment.data());
+            lineStart = block.end + 1;
+            data = newLine + 1;
         }
+
+        offset += segment.size();
+    }
+
+    auto &lastBlock { blocks.emplace_back() };
+    lastBlock.start = lineStart;
+    lastBlock.end = end;
+
+    for (auto &block : blocks)
+        shapeBlock(block);
+
+    replaceBlocks(first, last, std::move(blocks));
+}
+
+void AKText::reshapeBlocks(size_t first, size_t last) noexcept
+{
+    std::vector<Block> blocks(last - first);
+
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        blocks[i].start = m_blocks[first + i].start;
+        blocks[i].end = m_blocks[first + i].end;
+        shapeBlock(blocks[i]);
     }
+
+    replaceBlocks(first, last, std::move(blocks));
 }
 
-void AKText::updateParagraph() noexcept
+void AKText::replaceBlocks(size_t first, size_t last, std::vector<Block> &&blocks) noexcept
 {
-    m_builder = skia::textlayout::ParagraphBuilderImpl::make(m_paragraphStyle, AKApp::Get()->fontCollection());
+    std::vector<Block> prev(std::make_move_iterator(m_blocks.begin() + first), std::make_move_iterator(m_blocks.begin() + last));
+    const size_t count { blocks.size() };
+    m_blocks.erase(m_blocks.begin() + first, m_blocks.begin() + last);
+    m_blocks.insert(m_blocks.begin() + first, std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
 
-    const size_t A { 0 };
-    const size_t B { codePointByteOffset(m_selection[0]) };
-    const size_t C { codePointByteOffset(m_selection[0] + m_selection[1]) };
-    const size_t D { m_skText.size() };
+    SkScalar top { first == 0 ? 0.f : m_blocks[first - 1].top + m_blocks[first - 1].paragraph->getHeight() };
 
-    const std::string start { m_skText.substr(A, B) };
-    const std::string middle { m_skText.substr(B, C - B) };
-    const std::string end { m_skText.substr(C, D - C + 1) };
+    for (size_t i = first; i < first + count; i++)
+    {
+        m_blocks[i].top = top;
+        top += m_blocks[i].paragraph->getHeight();
+    }
 
-    if (!start.empty())
+    // Once a following block keeps its position, so do the rest
+    for (size_t i = first + count; i < m_blocks.size() && m_blocks[i].top != top; i++)
     {
-        m_builder->pushStyle(m_textStyle);
-        m_builder->addText(start.c_str());
-        m_builder->pop();
+        damageBlock(m_blocks[i]);
+        m_blocks[i].top = top;
+        damageBlock(m_blocks[i]);
+        top += m_blocks[i].paragraph->getHeight();
     }
 
-    if (!middle.empty())
+    if (prev.size() != count)
     {
-        m_builder->pushStyle(m_selectedStyle);
-        m_builder->addText(middle.c_str());
-        m_builder->pop();
+        for (const auto &block : prev)
+            damageBlock(block);
+
+        for (size_t i = first; i < first + count; i++)
+            damageBlock(m_blocks[i]);
+
+        return;
     }
 
-    if (!end.empty())
+    for (size_t i = 0; i < count; i++)
     {
-        m_builder->pushStyle(m_textStyle);
-        m_builder->addText(end.c_str());
-        m_builder->pop();
+        const Block &before { prev[i] };
+        const Block &after { m_blocks[first + i] };
+
+        if (before.top != after.top)
+        {
+            damageBlock(before);
+            damageBlock(after);
+            continue;
+        }
+
+        const SkIPoint offset { 0, SkScalarFloorToInt(after.top) };
+        const size_t bands { std::max(before.bands.size(), after.bands.size()) };
+
+        for (size_t j = 0; j < bands; j++)
+        {
+            const LineBand *a { j < before.bands.size() ? &before.bands[j] : nullptr };
+            const LineBand *b { j < after.bands.size() ? &after.bands[j] : nullptr };
+
+            if (a && b && *a == *b)
+                continue;
+
+            if (a)
+                addDamage(lineBandDamage(a->rect.makeOffset(offset)));
+
+            if (b)
+                addDamage(lineBandDamage(b->rect.makeOffset(offset)));
+        }
     }
+}
 
-    // std::cout << "Text [" << m_selection[0] << "," << m_selection[1] << "](" << A << "," << B << "," << C << "," << D << "): " << start << "_" << middle << "_" << end << std::endl;
+void AKText::shapeBlock(Block &block) const noexcept
+{
+    auto builder { skia::textlayout::ParagraphBuilderImpl::make(m_paragraphStyle, AKApp::Get()->fontCollection()) };
+    const size_t length { block.end - block.start };
+    const size_t selA { std::clamp(codePointByteOffset(m_selection[0]), block.start, block.end) - block.start };
+    const size_t selB { std::clamp(codePointByteOffset(m_selection[0] + m_selection[1]), block.start, block.end) - block.start };
+
+    // The builder copies the text, segments are passed directly from the buffer without moving its gap
+    const auto addRange { [&](const skia::textlayout::TextStyle &style, const skia::textlayout::TextStyle &tabStyle, size_t begin, size_t end) {
+        if (begin >= end)
+            return;
+
+        const auto [a, b] { m_buffer.segments(block.start + begin, block.start + end) };
+        builder->pushStyle(style);
+
+        for (auto segment : { a, b })
+        {
+            // Tabs are shaped as a single widened space, keeping text() offsets valid in the paragraph
+            size_t tab;
+
+            while ((tab = segment.find('\t')) != std::string_view::npos)
+            {
+                if (tab > 0)
+                    builder->addText(segment.data(), tab);
+
+                builder->pushStyle(tabStyle);
+                builder->addText(" ", 1);
+                builder->pop();
+                segment.remove_prefix(tab + 1);
+            }
+
+            if (!segment.empty())
+                builder->addText(segment.data(), segment.size());
+        }
+
+        builder->pop();
+    }};
+
+    // Empty lines still need a style for their height
+    builder->pushStyle(m_textStyle);
+    addRange(m_textStyle, m_tabStyle, 0, selA);
+    addRange(m_selectedStyle, m_selectedTabStyle, selA, selB);
+    addRange(m_textStyle, m_tabStyle, selB, length);
+    builder->pop();
+
+    block.paragraph = builder->Build();
+    block.paragraph->layout(3000000);
+    block.picture.reset();
+    block.bands.clear();
+
+    std::vector<skia::textlayout::LineMetrics> metrics;
+    block.paragraph->getLineMetrics(metrics);
+    block.bands.reserve(metrics.size());
+
+    for (const auto &line : metrics)
+    {
+        // Lines are contiguous, start where the previous one ended to include leading spaces
+        const size_t start { block.bands.empty() ? 0 : block.bands.back().end };
+        auto &band { block.bands.emplace_back() };
+        band.start = start;
+        band.end = std::clamp(line.fEndIncludingNewline, start, length);
+        band.hash = m_buffer.hash(block.start + band.start, block.start + band.end);
+        band.selStart = std::max(selA, band.start);
+        band.selEnd = std::min(selB, band.end);
+
+        if (band.selStart >= band.selEnd)
+            band.selStart = band.selEnd = 0;
+
+        const SkScalar top { SkScalar(line.fBaseline - line.fAscent) };
+        band.rect = SkIRect::MakeLTRB(
+            SkScalarFloorToInt(line.fLeft),
+            SkScalarFloorToInt(top),
+            SkScalarCeilToInt(line.fLeft + line.fWidth),
+            SkScalarCeilToInt(top + line.fHeight));
+    }
+}
+
+void AKText::damageBlock(const Block &block) noexcept
+{
+    const SkIPoint offset { 0, SkScalarFloorToInt(block.top) };
+
+    for (const auto &band : block.bands)
+        addDamage(lineBandDamage(band.rect.makeOffset(offset)));
+}
+
+size_t AKText::blockAt(size_t byte) const noexcept
+{
+    const auto it { std::upper_bound(m_blocks.begin(), m_blocks.end(), byte, [](size_t byte, const Block &block) {
+        return byte < block.start;
+    })};
+
+    return it == m_blocks.begin() ? 0 : size_t(it - m_blocks.begin()) - 1;
+}
+
+size_t AKText::blockAtY(SkScalar y) const noexcept
+{
+    const auto it { std::upper_bound(m_blocks.begin(), m_blocks.end(), y, [](SkScalar y, const Block &block) {
+        return y < block.top;
+    })};
 
-    m_paragraph = m_builder->Build();
-    m_paragraph->layout(3000000);
+    return it == m_blocks.begin() ? 0 : size_t(it - m_blocks.begin()) - 1;
 }
@@ -2,6 +2,8 @@
 #define CZ_AKTEXT_H
 
 #include <CZ/AK/Nodes/AKBakeable.h>
+#include <CZ/AK/AKTextBuffer.h>
+#include <CZ/skia/core/SkPicture.h>
 
 #include <CZ/skia/modules/skparagraph/src/ParagraphImpl.h>
 #include <CZ/skia/modules/skparagraph/src/ParagraphBuilderImpl.h>
@@ -25,7 +27,28 @@ public:
     AKText(const std::string &text, AKNode *parent = nullptr) noexcept;
 
     bool setText(const std::string &text) noexcept;
+
+    /**
+     * @brief Replaces a range of code points with UTF-8 text.
+     *
+     * Unlike setText(), only the edited range of the text buffer and code point offsets is updated
+     * and only the edited lines are reshaped, which keeps typing into large texts cheap.
+     * Indices refer to text() code points. The selection is cleared.
+     *
+     * @return true if the text changed.
+     */
+    bool replaceText(size_t codePoint, size_t count, const std::string &utf8) noexcept;
+    bool insertText(size_t codePoint, const std::string &utf8) noexcept { return replaceText(codePoint, 0, utf8); }
+    bool eraseText(size_t codePoint, size_t count) noexcept { return replaceText(codePoint, count, ""); }
+
     const std::string &text() const noexcept;
+
+    /**
+     * @brief The text as shaped.
+     *
+     * Tabs are replaced by single spaces, widened to four spaces when shaped, so byte
+     * and code point offsets are the same as in text().
+     */
     const std::string &skText() const noexcept;
 
     bool setTextStyle(const skia::textlayout::TextStyle &textStyle) noexcept;
@@ -54,20 +77,84 @@ public:
      */
     size_t codePointByteOffset(size_t codePoint) const noexcept;
 
+    /**
+     * @brief Number of code points in text().
+     */
+    size_t codePointCount() const noexcept;
+
     CZSignal<> onSelectionChanged;
     CZSignal<> onTextChanged;
 
 protected:
+    /* Snapshot of a paragraph line used to detect which lines need to be repainted */
+    struct LineBand
+    {
+        // Byte range relative to the block start
+        size_t start, end;
+
+        // Hash of the line bytes
+        size_t hash;
+
+        // Selected byte range within the line, relative to the block start (empty if none)
+        size_t selStart, selEnd;
+
+        // Line box relative to the block top
+        SkIRect rect;
+
+        bool operator==(const LineBand &other) const noexcept
+        {
+            return start == other.start && end == other.end && hash == other.hash &&
+                   selStart == other.selStart && selEnd == other.selEnd && rect == other.rect;
+        }
+    };
+
+    /* A '\n' separated line, shaped as its own paragraph so that edits only reshape the lines they touch */
+    struct Block
+    {
+        // Byte range in the buffer, excluding the '\n'
+        size_t start { 0 }, end { 0 };
+
+        // Vertical position in node-local coords
+        SkScalar top { 0.f };
+        std::unique_ptr<skia::textlayout::Paragraph> paragraph;
+
+        // Recorded glyph runs of paragraph, replayed when rebaking without paragraph changes (e.g. scale changes)
+        sk_sp<SkPicture> picture;
+        std::vector<LineBand> bands;
+    };
+
     void bakeEvent(const AKBakeEvent &event) override;
     void updateDimensions() noexcept;
-    void updateCodePointByteOffsets() noexcept;
-    void updateParagraph() noexcept;
-    std::string m_text, m_skText;
-    std::vector<size_t> m_codePointByteOffsets;
-    skia::textlayout::TextStyle m_textStyle, m_selectedStyle;
+
+    /* Clears the selection before an edit of [begin, end), reshaping the selected blocks the edit doesn't replace */
+    bool clearSelection(size_t begin, size_t end) noexcept;
+    void onTextEdited(size_t begin, size_t oldEnd, size_t newEnd, bool selectionCleared) noexcept;
+
+    /* Replaces the blocks spanning the edited byte range [begin, oldEnd), which now spans [begin, newEnd) */
+    void updateBlocks(size_t begin, size_t oldEnd, size_t newEnd) noexcept;
+
+    /* Reshapes blocks [first, last) in place, e.g. after a selection or style change */
+    void reshapeBlocks(size_t first, size_t last) noexcept;
+
+    /* Replaces blocks [first, last), positions the following ones and damages only the bands that changed */
+    void replaceBlocks(size_t first, size_t last, std::vector<Block> &&blocks) noexcept;
+    void shapeBlock(Block &block) const noexcept;
+    void damageBlock(const Block &block) noexcept;
+
+    /* Index of the block containing a byte offset or vertical position */
+    size_t blockAt(size_t byte) const noexcept;
+    size_t blockAtY(SkScalar y) const noexcept;
+
+    // Raw text, m_text, m_skText and m_codePointByteOffsets are lazily copied from it
+    AKTextBuffer m_buffer;
+    mutable std::string m_text, m_skText;
+    mutable std::vector<size_t> m_codePointByteOffsets;
+    mutable bool m_textValid { true }, m_skTextValid { true }, m_codePointByteOffsetsValid { true };
+    std::vector<Block> m_blocks;
+
+    // The tab styles widen a single space to the width of four
+    skia::textlayout::TextStyle m_textStyle, m_selectedStyle, m_tabStyle, m_selectedTabStyle;
     skia::textlayout::ParagraphStyle m_paragraphStyle;
-    std::unique_ptr<skia::textlayout::ParagraphBuilder> m_builder;
-    std::unique_ptr<skia::textlayout::Paragraph> m_paragraph;
     size_t m_selection[2] { 0, 0 };
 };
 
@@ -19,11 +19,11 @@ AKTextCaret::AKTextCaret(AKNode *parent) noexcept : AKThreePatch(CZOrientation::
 
     m_blinkAnimation.setDuration(1200);
 
-    m_blinkAnimation.setOnUpdateCallback([this](CZAnimation *anim){
+    m_blinkAnimation.setOnUpdateCallback([this](AKAnimation *anim){
         setOpacity((1.f + SkScalarCos(anim->value() * M_PI * 2.f)) * 0.5f);
     });
 
-    m_blinkAnimation.setOnFinishCallback([this](CZAnimation *anim){
+    m_blinkAnimation.setOnFinishCallback([this](AKAnimation *anim){
         if (animated())
             anim->start();
     });
@@ -57,6 +57,17 @@ void AKTextCaret::layoutEvent(const CZLayoutEvent &event)
 
 void AKTextCaret::updateDimensions() noexcept
 {
-    setImage(theme()->textCaretVThreePatchImage(scale()));
+    auto image { theme()->textCaretVThreePatchImage(scale()) };
+    setAssetPending(!image);
+
+    if (!image)
+        return;
+
+    setImage(image);
     setImageScale(scale());
 }
+
+void AKTextCaret::assetsReadyEvent()
+{
+    updateDimensions();
+}
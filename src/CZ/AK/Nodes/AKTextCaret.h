@@ -2,7 +2,7 @@
 #define CZ_AKTEXTCARET_H
 
 #include <CZ/AK/Nodes/AKThreePatch.h>
-#include <CZ/Core/CZLinearAnimation.h>
+#include <CZ/AK/AKAnimation.h>
 
 /**
  * @brief Blinking caret for text fields.
@@ -15,8 +15,9 @@ public:
     bool animated() const noexcept { return m_animated; };
 protected:
     void layoutEvent(const CZLayoutEvent &event) override;
+    void assetsReadyEvent() override;
     void updateDimensions() noexcept;
-    CZLinearAnimation m_blinkAnimation;
+    AKAnimation m_blinkAnimation { *this };
     bool m_animated { false };
 };
 
@@ -17,32 +17,6 @@
 
 using namespace CZ;
 
-static size_t utf8CharLength(char c)
-{
-    if ((c & 0x80) == 0) return 1;
-    if ((c & 0xE0) == 0xC0) return 2;
-    if ((c & 0xF0) == 0xE0) return 3;
-    if ((c & 0xF8) == 0xF0) return 4;
-    return 0; // Invalid UTF-8
-}
-
-void removeUTF8CharAt(std::string &str, size_t index) {
-    size_t size = 0;
-    Int32 i = index;
-    while (size == 0 && i >= 0) {
-        size = utf8CharLength(str[i]);
-
-        if (size == 0)
-        {
-            i--;
-            continue;
-        }
-
-        str.erase(i, size);
-        return;
-    }
-}
-
 AKTextField::AKTextField(AKNode *parent) noexcept : AKContainer(YGFlexDirection::YGFlexDirectionRow, true, parent)
 {
     auto app { AKApp::Get() };
@@ -149,7 +123,7 @@ void AKTextField::keyboardKeyEvent(const CZKeyboardKeyEvent &e)
     if (keymap->pressedKeys().contains(KEY_A) &&
         (keymap->pressedKeys().contains(KEY_LEFTCTRL) || keymap->pressedKeys().contains(KEY_RIGHTCTRL)))
     {
-        m_text.setSelection(0, m_text.codePointByteOffsets().size());
+        m_text.setSelection(0, m_text.codePointCount());
     }
     else if (e.symbol == XKB_KEY_Tab)
     {
@@ -209,7 +183,7 @@ void AKTextField::pointerButtonEvent(const CZPointerButtonEvent &event)
             m_selectionStart = m_text.codePointAt(
                 akPointer().pos().x() - SkScalar(m_text.worldRect().x()),
                 akPointer().pos().y() - SkScalar(m_text.worldRect().y()));
-            m_caretRightOffset = m_text.codePointByteOffsets().size()  - m_selectionStart;
+            m_caretRightOffset = m_text.codePointCount()  - m_selectionStart;
             updateCaretPos();
             m_interactiveSelection = true;
             if (scene())
@@ -271,7 +245,13 @@ void AKTextField::updateDimensions() noexcept
 
 void AKTextField::updateScale() noexcept
 {
-    m_hThreePatch.setImage(theme()->textFieldRoundHThreePatchImage(scale()));
+    auto image { theme()->textFieldRoundHThreePatchImage(scale()) };
+    setAssetPending(!image);
+
+    if (!image)
+        return;
+
+    m_hThreePatch.setImage(image);
     m_hThreePatch.setImageScale(scale());
 }
 
@@ -286,10 +266,10 @@ void AKTextField::updateTextPosition() noexcept
 
 void AKTextField::updateCaretPos() noexcept
 {
-    if (m_caretRightOffset > m_text.codePointByteOffsets().size())
-        m_caretRightOffset = m_text.codePointByteOffsets().size();
+    if (m_caretRightOffset > m_text.codePointCount())
+        m_caretRightOffset = m_text.codePointCount();
 
-    if (m_text.codePointByteOffsets().empty())
+    if (m_text.codePointCount() == 0)
     {
         m_caret.layout().setPosition(
             YGEdgeLeft,
@@ -298,70 +278,55 @@ void AKTextField::updateCaretPos() noexcept
     else if (m_caretRightOffset == 0)
         m_caret.layout().setPosition(
             YGEdgeLeft,
-            m_text.glyphAtCodePoint(m_text.codePointByteOffsets().size() - 1).right() - m_caret.layout().calculatedWidth()/2.f);
+            m_text.glyphAtCodePoint(m_text.codePointCount() - 1).right() - m_caret.layout().calculatedWidth()/2.f);
     else
         m_caret.layout().setPosition(
             YGEdgeLeft,
-            m_text.glyphAtCodePoint(m_text.codePointByteOffsets().size() - m_caretRightOffset).left() - m_caret.layout().calculatedWidth()/2.f);
+            m_text.glyphAtCodePoint(m_text.codePointCount() - m_caretRightOffset).left() - m_caret.layout().calculatedWidth()/2.f);
 }
 
 void AKTextField::addUTF8(const char *utf8) noexcept
 {
+    const size_t count { m_text.codePointCount() };
+
     if (m_text.selection()[1] == 0)
     {
-        if (m_caretRightOffset == 0)
-        {
-            if (m_text.setText(m_text.text() + utf8))
-                updateTextPosition();
-        }
-        else
-        {
-            const Int64 caretPos = Int64(m_text.codePointByteOffsets().size()) - m_caretRightOffset;
-            std::string newText = m_text.skText().substr(0, m_text.codePointByteOffset(caretPos)) + utf8 + m_text.skText().substr(m_text.codePointByteOffset(caretPos));
-            if (m_text.setText(newText))
-                updateTextPosition();
-        }
+        const size_t caretPos { count - std::min(m_caretRightOffset, count) };
+
+        if (m_text.insertText(caretPos, utf8))
+            updateTextPosition();
     }
     else
     {
-        m_caretRightOffset = std::max(Int64(m_text.codePointByteOffsets().size()) - Int64(m_text.selection()[0] + m_text.selection()[1]), Int64(0));
-        std::string newText = m_text.skText().substr(0, m_text.codePointByteOffset(m_text.selection()[0])) + utf8 + m_text.skText().substr( m_text.codePointByteOffset(m_text.selection()[0] + m_text.selection()[1]));
-        if (m_text.setText(newText))
+        m_caretRightOffset = count - m_text.selection()[0] - m_text.selection()[1];
+
+        if (m_text.replaceText(m_text.selection()[0], m_text.selection()[1], utf8))
             updateTextPosition();
     }
 }
 
 void AKTextField::removeUTF8() noexcept
 {
-    if (m_text.text().empty())
+    const size_t count { m_text.codePointCount() };
+
+    if (count == 0)
         return;
 
     if (m_text.selection()[1] == 0)
     {
-        if (m_caretRightOffset == 0)
-        {
-            std::string str { m_text.text() };
-            removeUTF8CharAt(str, str.size() - 1);
-            if (m_text.setText(str))
-                updateTextPosition();
-        }
-        else
-        {
-            const Int64 caretPos = Int64(m_text.codePointByteOffsets().size()) - m_caretRightOffset;
+        const size_t caretPos { count - std::min(m_caretRightOffset, count) };
 
-            if (caretPos == 0)
-                return;
+        if (caretPos == 0)
+            return;
 
-            std::string newText = m_text.skText().substr(0, m_text.codePointByteOffset(caretPos - 1)) + m_text.skText().substr(m_text.codePointByteOffset(caretPos));
-            if (m_text.setText(newText))
-                updateTextPosition();
-        }
+        if (m_text.eraseText(caretPos - 1, 1))
+            updateTextPosition();
     }
     else
     {
-        m_caretRightOffset = std::max(Int64(m_text.codePointByteOffsets().size()) - Int64(m_text.selection()[0] + m_text.selection()[1]), Int64(0));
-        std::string newText = m_text.skText().substr(0, m_text.codePointByteOffset(m_text.selection()[0])) +  m_text.skText().substr( m_text.codePointByteOffset(m_text.selection()[0] + m_text.selection()[1]));
-        if (m_text.setText(newText))
+        m_caretRightOffset = count - m_text.selection()[0] - m_text.selection()[1];
+
+        if (m_text.eraseText(m_text.selection()[0], m_text.selection()[1]))
             updateTextPosition();
     }
 }
@@ -378,7 +343,7 @@ void AKTextField::moveCaretRight() noexcept
     }
     else
     {
-        m_caretRightOffset = m_text.codePointByteOffsets().size() - m_text.selection()[0] - m_text.selection()[1];
+        m_caretRightOffset = m_text.codePointCount() - m_text.selection()[0] - m_text.selection()[1];
         updateCaretPos();
     }
     m_caret.setVisible(true);
@@ -390,9 +355,14 @@ void AKTextField::moveCaretLeft() noexcept
     if (m_text.selection()[1] == 0)
         m_caretRightOffset++;
     else
-        m_caretRightOffset = m_text.codePointByteOffsets().size() - m_text.selection()[0];
+        m_caretRightOffset = m_text.codePointCount() - m_text.selection()[0];
 
     updateCaretPos();
     m_caret.setVisible(true);
     m_text.setSelection(0, 0);
 }
+
+void AKTextField::assetsReadyEvent()
+{
+    updateScale();
+}
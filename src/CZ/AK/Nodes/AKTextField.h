@@ -26,6 +26,7 @@ protected:
     void pointerButtonEvent(const CZPointerButtonEvent &event) override;
     void pointerMoveEvent(const CZPointerMoveEvent &event) override;
     void windowStateEvent(const CZWindowStateEvent &event) override;
+    void assetsReadyEvent() override;
     void updateDimensions() noexcept;
     void updateScale() noexcept;
     void updateTextPosition() noexcept;
@@ -0,0 +1,260 @@
+#include "CZ/AK/ThirdParty/Material/cam/hct_batch.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <array>
+
+#include "CZ/AK/ThirdParty/Material/cam/cam.h"
+#include "CZ/AK/ThirdParty/Material/cam/hct_solver.h"
+#include "CZ/AK/ThirdParty/Material/cam/viewing_conditions.h"
+#include "CZ/AK/ThirdParty/Material/utils/utils.h"
+
+namespace material_color_utilities {
+
+namespace {
+
+// Elements converted per block, small enough for the temporaries to stay in
+// the L1 cache.
+constexpr size_t kBlockSize = 256;
+
+constexpr float kPiF = 3.14159265358979323846f;
+
+// Constants derived from kDefaultViewingConditions, in single precision.
+struct FastConstants {
+  float rgb_d[3];
+  float fl;
+  float fl_root;
+  float aw;
+  float nbb;
+  float n_c_ncb;
+  float c_z;
+  float inv_c_z;
+  float q_coeff;
+  float alpha_coeff;
+  float t_inner_coeff;
+};
+
+const FastConstants& GetFastConstants() {
+  static const FastConstants constants = [] {
+    const ViewingConditions& vc = kDefaultViewingConditions;
+    const double alpha_coeff =
+        pow(1.64 - pow(0.29, vc.background_y_to_white_point_y), 0.73);
+    FastConstants c;
+    c.rgb_d[0] = vc.rgb_d[0];
+    c.rgb_d[1] = vc.rgb_d[1];
+    c.rgb_d[2] = vc.rgb_d[2];
+    c.fl = vc.fl;
+    c.fl_root = vc.fl_root;
+    c.aw = vc.aw;
+    c.nbb = vc.nbb;
+    c.n_c_ncb = vc.n_c * vc.ncb;
+    c.c_z = vc.c * vc.z;
+    c.inv_c_z = 1.0 / vc.c / vc.z;
+    c.q_coeff = (4.0 / vc.c) * (vc.aw + 4.0) * vc.fl_root;
+    c.alpha_coeff = alpha_coeff;
+    c.t_inner_coeff = 1.0 / alpha_coeff;
+    return c;
+  }();
+  return constants;
+}
+
+const std::array<float, 256>& GetLinearizedTable() {
+  static const std::array<float, 256> table = [] {
+    std::array<float, 256> t;
+    for (int i = 0; i < 256; i++) {
+      t[i] = Linearized(i);
+    }
+    return t;
+  }();
+  return table;
+}
+
+float SignumF(float num) { return num < 0.f ? -1.f : (num == 0.f ? 0.f : 1.f); }
+
+int DelinearizedF(float rgb_component) {
+  const float normalized = rgb_component / 100.f;
+  const float delinearized =
+      normalized <= 0.0031308f
+          ? normalized * 12.92f
+          : 1.055f * powf(normalized, 1.f / 2.4f) - 0.055f;
+  return std::clamp((int)lroundf(delinearized * 255.f), 0, 255);
+}
+
+void HctsFromIntsFast(const Argb* argbs, size_t count, double* hues,
+                      double* chromas, double* tones) {
+  const FastConstants& k = GetFastConstants();
+  const std::array<float, 256>& lin = GetLinearizedTable();
+
+  float r_d[kBlockSize], g_d[kBlockSize], b_d[kBlockSize], y[kBlockSize];
+
+  for (size_t start = 0; start < count; start += kBlockSize) {
+    const size_t n = std::min(kBlockSize, count - start);
+    const Argb* block = argbs + start;
+
+    // Linear parts, no branches or calls so the loop can be vectorized.
+    for (size_t i = 0; i < n; i++) {
+      const float red_l = lin[(block[i] >> 16) & 0xff];
+      const float green_l = lin[(block[i] >> 8) & 0xff];
+      const float blue_l = lin[block[i] & 0xff];
+      const float x =
+          0.41233895f * red_l + 0.35762064f * green_l + 0.18051042f * blue_l;
+      const float yy = 0.2126f * red_l + 0.7152f * green_l + 0.0722f * blue_l;
+      const float z =
+          0.01932141f * red_l + 0.11916382f * green_l + 0.95034478f * blue_l;
+      r_d[i] = k.rgb_d[0] * (0.401288f * x + 0.650173f * yy - 0.051461f * z);
+      g_d[i] = k.rgb_d[1] * (-0.250268f * x + 1.204414f * yy + 0.045854f * z);
+      b_d[i] = k.rgb_d[2] * (-0.002079f * x + 0.048952f * yy + 0.953127f * z);
+      y[i] = yy;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      const float r_af = powf(k.fl * fabsf(r_d[i]) / 100.f, 0.42f);
+      const float g_af = powf(k.fl * fabsf(g_d[i]) / 100.f, 0.42f);
+      const float b_af = powf(k.fl * fabsf(b_d[i]) / 100.f, 0.42f);
+      const float r_a = SignumF(r_d[i]) * 400.f * r_af / (r_af + 27.13f);
+      const float g_a = SignumF(g_d[i]) * 400.f * g_af / (g_af + 27.13f);
+      const float b_a = SignumF(b_d[i]) * 400.f * b_af / (b_af + 27.13f);
+
+      const float a = (11.f * r_a + -12.f * g_a + b_a) / 11.f;
+      const float b = (r_a + g_a - 2.f * b_a) / 9.f;
+      const float u = (20.f * r_a + 20.f * g_a + 21.f * b_a) / 20.f;
+      const float p2 = (40.f * r_a + 20.f * g_a + b_a) / 20.f;
+
+      float hue = atan2f(b, a) * 180.f / kPiF;
+      if (hue < 0.f) {
+        hue += 360.f;
+      } else if (hue >= 360.f) {
+        hue -= 360.f;
+      }
+
+      const float ac = p2 * k.nbb;
+      const float j = 100.f * powf(ac / k.aw, k.c_z);
+      const float hue_prime = hue < 20.14f ? hue + 360.f : hue;
+      const float e_hue = 0.25f * (cosf(hue_prime * kPiF / 180.f + 2.f) + 3.8f);
+      const float p1 = 50000.f / 13.f * e_hue * k.n_c_ncb;
+      const float t = p1 * sqrtf(a * a + b * b) / (u + 0.305f);
+      const float alpha = powf(t, 0.9f) * k.alpha_coeff;
+
+      const float y_normalized = y[i] / 100.f;
+      const float tone = y_normalized <= 216.f / 24389.f
+                             ? (24389.f / 27.f) * y_normalized
+                             : 116.f * cbrtf(y_normalized) - 16.f;
+
+      hues[start + i] = hue;
+      chromas[start + i] = alpha * sqrtf(j / 100.f);
+      tones[start + i] = tone;
+    }
+  }
+}
+
+// Single precision port of FindResultByJ() in hct_solver.cc. Returns 0 when
+// the color can't be resolved this way.
+Argb FindResultByJFast(float hue_radians, float chroma, float y) {
+  const FastConstants& k = GetFastConstants();
+  float j = sqrtf(y) * 11.f;
+  const float e_hue = 0.25f * (cosf(hue_radians + 2.f) + 3.8f);
+  const float p1 = e_hue * (50000.f / 13.f) * k.n_c_ncb;
+  const float h_sin = sinf(hue_radians);
+  const float h_cos = cosf(hue_radians);
+
+  for (int iteration_round = 0; iteration_round < 5; iteration_round++) {
+    const float j_normalized = j / 100.f;
+    const float alpha =
+        chroma == 0.f || j == 0.f ? 0.f : chroma / sqrtf(j_normalized);
+    const float t = powf(alpha * k.t_inner_coeff, 1.f / 0.9f);
+    const float ac = k.aw * powf(j_normalized, k.inv_c_z);
+    const float p2 = ac / k.nbb;
+    const float gamma = 23.f * (p2 + 0.305f) * t /
+                        (23.f * p1 + 11.f * t * h_cos + 108.f * t * h_sin);
+    const float a = gamma * h_cos;
+    const float b = gamma * h_sin;
+    float scaled[3] = {
+        (460.f * p2 + 451.f * a + 288.f * b) / 1403.f,
+        (460.f * p2 - 891.f * a - 261.f * b) / 1403.f,
+        (460.f * p2 - 220.f * a - 6300.f * b) / 1403.f,
+    };
+
+    for (float& adapted : scaled) {
+      const float adapted_abs = fabsf(adapted);
+      const float base =
+          fmaxf(0.f, 27.13f * adapted_abs / (400.f - adapted_abs));
+      adapted = SignumF(adapted) * powf(base, 1.f / 0.42f);
+    }
+
+    const float lin_r = 1373.2198709594231f * scaled[0] -
+                        1100.4251190754821f * scaled[1] -
+                        7.278681089101213f * scaled[2];
+    const float lin_g = -271.815969077903f * scaled[0] +
+                        559.6580465940733f * scaled[1] -
+                        32.46047482791194f * scaled[2];
+    const float lin_b = 1.9622899599665666f * scaled[0] -
+                        57.173814538844006f * scaled[1] +
+                        308.7233197812385f * scaled[2];
+
+    if (lin_r < 0.f || lin_g < 0.f || lin_b < 0.f) {
+      return 0;
+    }
+
+    const float fnj = 0.2126f * lin_r + 0.7152f * lin_g + 0.0722f * lin_b;
+
+    if (fnj <= 0.f) {
+      return 0;
+    }
+
+    if (iteration_round == 4 || fabsf(fnj - y) < 0.002f) {
+      if (lin_r > 100.01f || lin_g > 100.01f || lin_b > 100.01f) {
+        return 0;
+      }
+      return 0xFF000000 | (DelinearizedF(lin_r) << 16) |
+             (DelinearizedF(lin_g) << 8) | DelinearizedF(lin_b);
+    }
+
+    j = j - (fnj - y) * j / (2.f * fnj);
+  }
+  return 0;
+}
+
+}  // namespace
+
+void HctsFromInts(const Argb* argbs, size_t count, double* hues,
+                  double* chromas, double* tones, HctPrecision precision) {
+  if (precision == HctPrecision::kFast) {
+    HctsFromIntsFast(argbs, count, hues, chromas, tones);
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    const Cam cam = CamFromInt(argbs[i]);
+    hues[i] = cam.hue;
+    chromas[i] = cam.chroma;
+    tones[i] = LstarFromArgb(argbs[i]);
+  }
+}
+
+void IntsFromHcts(const double* hues, const double* chromas,
+                  const double* tones, size_t count, Argb* argbs,
+                  HctPrecision precision) {
+  if (precision == HctPrecision::kExact) {
+    for (size_t i = 0; i < count; i++) {
+      argbs[i] = SolveToInt(hues[i], chromas[i], tones[i]);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    const double chroma = chromas[i];
+    const double lstar = tones[i];
+
+    // Achromatic colors and colors outside the fast solver's range use the
+    // scalar path, which handles them exactly.
+    Argb argb = 0;
+    if (chroma >= 0.0001 && lstar >= 0.0001 && lstar <= 99.9999) {
+      const float hue_radians = SanitizeDegreesDouble(hues[i]) / 180.0 * kPi;
+      argb = FindResultByJFast(hue_radians, chroma, YFromLstar(lstar));
+    }
+    argbs[i] = argb != 0 ? argb : SolveToInt(hues[i], chroma, lstar);
+  }
+}
+
+}  // namespace material_color_utilities
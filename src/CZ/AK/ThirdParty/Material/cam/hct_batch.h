@@ -0,0 +1,46 @@
+#ifndef CPP_CAM_HCT_BATCH_H_
+#define CPP_CAM_HCT_BATCH_H_
+
+#include <cstddef>
+
+#include "CZ/AK/ThirdParty/Material/utils/utils.h"
+
+namespace material_color_utilities {
+
+/**
+ * Precision of the batch HCT conversions.
+ *
+ * `kExact`: results are bit-identical to the scalar path (Hct(argb),
+ *           SolveToInt()), which is used for each element.
+ * `kFast`:  single precision math over structure-of-arrays blocks. Measured
+ *           over all 2^24 opaque colors: hue within 0.011 degrees of the
+ *           scalar results for chroma >= 1 (0.05 below that, where hue is
+ *           barely defined), chroma within 0.0004 and tone within 0.00002.
+ *           About 1 in 20k ARGB results differ by one step in a channel.
+ *           Colors the fast solver can't resolve fall back to the scalar path.
+ *           ARGB -> HCT is about 3x faster than kExact. HCT -> ARGB is not
+ *           faster, the solver iterations dominate either way.
+ */
+enum class HctPrecision {
+  kExact,
+  kFast,
+};
+
+/**
+ * Converts `count` ARGB colors to HCT, writing each component into its own
+ * array.
+ */
+void HctsFromInts(const Argb* argbs, size_t count, double* hues,
+                  double* chromas, double* tones,
+                  HctPrecision precision = HctPrecision::kExact);
+
+/**
+ * Converts `count` HCT colors (one array per component) to ARGB.
+ */
+void IntsFromHcts(const double* hues, const double* chromas,
+                  const double* tones, size_t count, Argb* argbs,
+                  HctPrecision precision = HctPrecision::kExact);
+
+}  // namespace material_color_utilities
+
+#endif  // CPP_CAM_HCT_BATCH_H_
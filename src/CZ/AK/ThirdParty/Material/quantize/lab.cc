@@ -18,6 +18,10 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 #include "CZ/AK/ThirdParty/Material/utils/utils.h"
 
 namespace material_color_utilities {
@@ -93,4 +97,94 @@ Lab LabFromInt(const Argb argb) {
   return {l, a, b};
 }
 
+namespace {
+
+// GCC/Clang vector extensions, four lanes map to SSE and NEON registers.
+typedef float Float4 __attribute__((vector_size(16)));
+typedef int32_t Int4 __attribute__((vector_size(16)));
+
+constexpr size_t kBlockSize = 256;
+
+Float4 Select(Int4 mask, Float4 a, Float4 b) {
+  return (Float4)((mask & (Int4)a) | (~mask & (Int4)b));
+}
+
+// Cube root of non-negative values, exact to single precision in [1e-3, 2].
+Float4 Cbrt4(Float4 x) {
+  // Dividing the exponent bits by 3 gives a guess within a few percent.
+  const Float4 third = {1.f / 3.f, 1.f / 3.f, 1.f / 3.f, 1.f / 3.f};
+  const Int4 bits = __builtin_convertvector(
+                        __builtin_convertvector((Int4)x, Float4) * third,
+                        Int4) +
+                    709921077;
+  Float4 y = (Float4)bits;
+  for (int i = 0; i < 3; i++) {
+    y = (2.f * y + x / (y * y)) * third;
+  }
+  return y;
+}
+
+Float4 LabF4(Float4 t) {
+  const float e = 216.f / 24389.f;
+  const float kappa = 24389.f / 27.f;
+  return Select(t > e, Cbrt4(t), (kappa * t + 16.f) / 116.f);
+}
+
+}  // namespace
+
+void LabsFromInts(const Argb* argbs, size_t count, float* l, float* a,
+                  float* b) {
+  static const std::array<float, 256> linearized = [] {
+    std::array<float, 256> table;
+    for (int i = 0; i < 256; i++) {
+      table[i] = Linearized(i);
+    }
+    return table;
+  }();
+
+  alignas(16) float red_l[kBlockSize], green_l[kBlockSize], blue_l[kBlockSize];
+  alignas(16) float out_l[kBlockSize], out_a[kBlockSize], out_b[kBlockSize];
+
+  for (size_t start = 0; start < count; start += kBlockSize) {
+    const size_t n = std::min(kBlockSize, count - start);
+    const size_t lanes = (n + 3) & ~size_t(3);
+
+    // Table lookups are gathers, done before the SIMD part.
+    for (size_t i = 0; i < lanes; i++) {
+      const Argb argb = i < n ? argbs[start + i] : 0;
+      red_l[i] = linearized[(argb & 0x00ff0000) >> 16];
+      green_l[i] = linearized[(argb & 0x0000ff00) >> 8];
+      blue_l[i] = linearized[argb & 0x000000ff];
+    }
+
+    for (size_t i = 0; i < lanes; i += 4) {
+      Float4 r, g, bl;
+      memcpy(&r, red_l + i, sizeof(r));
+      memcpy(&g, green_l + i, sizeof(g));
+      memcpy(&bl, blue_l + i, sizeof(bl));
+      const Float4 x =
+          (0.41233895f * r + 0.35762064f * g + 0.18051042f * bl) /
+          float(kWhitePointD65[0]);
+      const Float4 y = (0.2126f * r + 0.7152f * g + 0.0722f * bl) /
+                       float(kWhitePointD65[1]);
+      const Float4 z =
+          (0.01932141f * r + 0.11916382f * g + 0.95034478f * bl) /
+          float(kWhitePointD65[2]);
+      const Float4 fx = LabF4(x);
+      const Float4 fy = LabF4(y);
+      const Float4 fz = LabF4(z);
+      const Float4 lab_l = 116.f * fy - 16.f;
+      const Float4 lab_a = 500.f * (fx - fy);
+      const Float4 lab_b = 200.f * (fy - fz);
+      memcpy(out_l + i, &lab_l, sizeof(lab_l));
+      memcpy(out_a + i, &lab_a, sizeof(lab_a));
+      memcpy(out_b + i, &lab_b, sizeof(lab_b));
+    }
+
+    memcpy(l + start, out_l, n * sizeof(float));
+    memcpy(a + start, out_a, n * sizeof(float));
+    memcpy(b + start, out_b, n * sizeof(float));
+  }
+}
+
 }  // namespace material_color_utilities
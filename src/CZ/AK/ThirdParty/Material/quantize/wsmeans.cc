@@ -20,6 +20,7 @@
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <map>
 #include <unordered_map>
 #include <vector>
@@ -38,14 +39,18 @@ struct Swatch {
   bool operator<(const Swatch& b) const { return population > b.population; }
 };
 
-struct DistanceToIndex {
-  double distance = 0.0;
-  int index = 0;
+// GCC/Clang vector extensions, four lanes map to SSE and NEON registers.
+typedef float Float4 __attribute__((vector_size(16)));
+typedef int32_t Int4 __attribute__((vector_size(16)));
 
-  bool operator<(const DistanceToIndex& a) const {
-    return distance < a.distance;
-  }
-};
+// Padding clusters are placed this far away so they are never the nearest.
+constexpr float kFarAway = 1e18f;
+
+// Clusters compared per step of the reassignment loop. Each group of four
+// keeps its own running minimum, so the compare/select chains of the groups
+// run in parallel instead of waiting on each other.
+constexpr int kClustersPerStep = 16;
+constexpr int kGroups = kClustersPerStep / 4;
 
 QuantizerResult QuantizeWsmeans(const std::vector<Argb>& input_pixels,
                                 const std::vector<Argb>& starting_clusters,
@@ -63,8 +68,6 @@ QuantizerResult QuantizeWsmeans(const std::vector<Argb>& input_pixels,
   std::unordered_map<Argb, int> pixel_to_count;
   std::vector<uint32_t> pixels;
   pixels.reserve(pixel_count);
-  std::vector<Lab> points;
-  points.reserve(pixel_count);
   for (Argb pixel : input_pixels) {
     // tested over 1000 runs with 128 colors, 12544 (112 x 112)
     // std::map 10.9 ms
@@ -77,12 +80,25 @@ QuantizerResult QuantizeWsmeans(const std::vector<Argb>& input_pixels,
 
     } else {
       pixels.push_back(pixel);
-      points.push_back(LabFromInt(pixel));
       pixel_to_count[pixel] = 1;
     }
   }
 
-  int cluster_count = std::min((int)max_colors, (int)points.size());
+  // Batch conversion of the unique pixels, one array per component
+  const size_t point_count = pixels.size();
+  std::vector<float> points_l(point_count), points_a(point_count),
+      points_b(point_count);
+  LabsFromInts(pixels.data(), point_count, points_l.data(), points_a.data(),
+               points_b.data());
+
+  // Avoids a hash lookup per point on each iteration
+  std::vector<int> counts;
+  counts.reserve(pixels.size());
+  for (Argb pixel : pixels) {
+    counts.push_back(pixel_to_count[pixel]);
+  }
+
+  int cluster_count = std::min((int)max_colors, (int)point_count);
 
   if (!starting_clusters.empty()) {
     cluster_count = std::min(cluster_count, (int)starting_clusters.size());
@@ -110,61 +126,102 @@ QuantizerResult QuantizeWsmeans(const std::vector<Argb>& input_pixels,
   }
 
   std::vector<int> cluster_indices;
-  cluster_indices.reserve(points.size());
+  cluster_indices.reserve(point_count);
 
   srand(42688);
-  for (size_t i = 0; i < points.size(); i++) {
+  for (size_t i = 0; i < point_count; i++) {
     cluster_indices.push_back(rand() % cluster_count);
   }
 
-  std::vector<std::vector<int>> index_matrix(
-      cluster_count, std::vector<int>(cluster_count, 0));
-
-  std::vector<std::vector<DistanceToIndex>> distance_to_index_matrix(
-      cluster_count, std::vector<DistanceToIndex>(cluster_count));
+  // Single precision copies of the clusters and their distances for the SIMD
+  // reassignment, padded to a multiple of kClustersPerStep.
+  const int padded_count =
+      (cluster_count + kClustersPerStep - 1) & ~(kClustersPerStep - 1);
+  alignas(16) float clusters_l[256], clusters_a[256], clusters_b[256];
+  std::vector<float> cluster_distances(cluster_count * padded_count,
+                                       kFarAway);
+  for (int j = cluster_count; j < padded_count; j++) {
+    clusters_l[j] = clusters_a[j] = clusters_b[j] = kFarAway;
+  }
 
   for (int iteration = 0; iteration < kMaxIterations; iteration++) {
-    // Calculate cluster distances
+    // Calculate cluster distances. Upstream also sorts each row into an index
+    // matrix that is never read, that work is skipped.
     for (int i = 0; i < cluster_count; i++) {
-      distance_to_index_matrix[i][i].distance = 0;
-      distance_to_index_matrix[i][i].index = i;
+      cluster_distances[i * padded_count + i] = 0;
       for (int j = i + 1; j < cluster_count; j++) {
-        double distance = clusters[i].DeltaE(clusters[j]);
-
-        distance_to_index_matrix[j][i].distance = distance;
-        distance_to_index_matrix[j][i].index = i;
-        distance_to_index_matrix[i][j].distance = distance;
-        distance_to_index_matrix[i][j].index = j;
-      }
-
-      std::vector<DistanceToIndex> row = distance_to_index_matrix[i];
-      std::sort(row.begin(), row.end());
-
-      for (int j = 0; j < cluster_count; j++) {
-        index_matrix[i][j] = row[j].index;
+        const float distance = clusters[i].DeltaE(clusters[j]);
+        cluster_distances[j * padded_count + i] = distance;
+        cluster_distances[i * padded_count + j] = distance;
       }
+      clusters_l[i] = clusters[i].l;
+      clusters_a[i] = clusters[i].a;
+      clusters_b[i] = clusters[i].b;
     }
 
-    // Reassign points
+    // Reassign points, comparing each point against four clusters per lane
+    // group. Each lane keeps its first strictly smaller distance, so the final
+    // reduction picks the same cluster as a sequential scan.
     bool color_moved = false;
-    for (size_t i = 0; i < points.size(); i++) {
-      Lab point = points[i];
+    for (size_t i = 0; i < point_count; i++) {
+      const float l = points_l[i], a = points_a[i], b = points_b[i];
 
       int previous_cluster_index = cluster_indices[i];
-      Lab previous_cluster = clusters[previous_cluster_index];
-      double previous_distance = point.DeltaE(previous_cluster);
-      double minimum_distance = previous_distance;
-      int new_cluster_index = -1;
+      const float previous_l = l - clusters_l[previous_cluster_index];
+      const float previous_a = a - clusters_a[previous_cluster_index];
+      const float previous_b = b - clusters_b[previous_cluster_index];
+      const float previous_distance = previous_l * previous_l +
+                                      previous_a * previous_a +
+                                      previous_b * previous_b;
+
+      const float* distances =
+          &cluster_distances[previous_cluster_index * padded_count];
+      const float max_cluster_distance = 4 * previous_distance;
+
+      Float4 minimum[kGroups];
+      Int4 minimum_index[kGroups];
+      Int4 index[kGroups];
+      for (int g = 0; g < kGroups; g++) {
+        minimum[g] = Float4{} + previous_distance;
+        minimum_index[g] = Int4{} - 1;
+        index[g] = Int4{0, 1, 2, 3} + 4 * g;
+      }
 
-      for (int j = 0; j < cluster_count; j++) {
-        if (distance_to_index_matrix[previous_cluster_index][j].distance >=
-            4 * previous_distance) {
-          continue;
+      for (int j = 0; j < padded_count; j += kClustersPerStep) {
+        for (int g = 0; g < kGroups; g++) {
+          const int k = j + 4 * g;
+          Float4 cluster_l, cluster_a, cluster_b, cluster_distance;
+          memcpy(&cluster_l, clusters_l + k, sizeof(cluster_l));
+          memcpy(&cluster_a, clusters_a + k, sizeof(cluster_a));
+          memcpy(&cluster_b, clusters_b + k, sizeof(cluster_b));
+          memcpy(&cluster_distance, distances + k, sizeof(cluster_distance));
+          const Float4 d_l = l - cluster_l;
+          const Float4 d_a = a - cluster_a;
+          const Float4 d_b = b - cluster_b;
+          const Float4 distance = d_l * d_l + d_a * d_a + d_b * d_b;
+          const Int4 closer = (cluster_distance < max_cluster_distance) &
+                              (distance < minimum[g]);
+          minimum[g] = (Float4)((closer & (Int4)distance) |
+                                (~closer & (Int4)minimum[g]));
+          minimum_index[g] =
+              (closer & index[g]) | (~closer & minimum_index[g]);
+          index[g] += kClustersPerStep;
         }
-        double distance = point.DeltaE(clusters[j]);
-        if (distance < minimum_distance) {
-          minimum_distance = distance;
-          new_cluster_index = j;
+      }
+
+      float minimum_distance = previous_distance;
+      int new_cluster_index = -1;
+      for (int g = 0; g < kGroups; g++) {
+        for (int lane = 0; lane < 4; lane++) {
+          if (minimum_index[g][lane] == -1) {
+            continue;
+          }
+          if (minimum[g][lane] < minimum_distance ||
+              (minimum[g][lane] == minimum_distance &&
+               minimum_index[g][lane] < new_cluster_index)) {
+            minimum_distance = minimum[g][lane];
+            new_cluster_index = minimum_index[g][lane];
+          }
         }
       }
       if (new_cluster_index != -1) {
@@ -189,15 +246,14 @@ QuantizerResult QuantizeWsmeans(const std::vector<Argb>& input_pixels,
       pixel_count_sums[i] = 0;
     }
 
-    for (size_t i = 0; i < points.size(); i++) {
+    for (size_t i = 0; i < point_count; i++) {
       int clusterIndex = cluster_indices[i];
-      Lab point = points[i];
-      int count = pixel_to_count[pixels[i]];
+      int count = counts[i];
 
       pixel_count_sums[clusterIndex] += count;
-      component_a_sums[clusterIndex] += (point.l * count);
-      component_b_sums[clusterIndex] += (point.a * count);
-      component_c_sums[clusterIndex] += (point.b * count);
+      component_a_sums[clusterIndex] += (points_l[i] * count);
+      component_b_sums[clusterIndex] += (points_a[i] * count);
+      component_c_sums[clusterIndex] += (points_b[i] * count);
     }
 
     for (int i = 0; i < cluster_count; i++) {
@@ -249,7 +305,7 @@ QuantizerResult QuantizeWsmeans(const std::vector<Argb>& input_pixels,
   }
 
   std::map<Argb, Argb> input_pixel_to_cluster_pixel;
-  for (size_t i = 0; i < points.size(); i++) {
+  for (size_t i = 0; i < point_count; i++) {
     int pixel = pixels[i];
     int cluster_index = cluster_indices[i];
     int cluster_argb = all_cluster_argbs[cluster_index];
@@ -0,0 +1,95 @@
+/*
+ * Times HctsFromInts() and IntsFromHcts() in both precision modes against
+ * converting one color at a time with Hct.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "CZ/AK/ThirdParty/Material/cam/hct.h"
+#include "CZ/AK/ThirdParty/Material/cam/hct_batch.h"
+#include "CZ/AK/ThirdParty/Material/cam/hct_solver.h"
+
+using namespace material_color_utilities;
+
+namespace {
+
+constexpr size_t kCount = 200000;
+constexpr int kRuns = 5;
+
+// Best of kRuns, in milliseconds.
+template <typename F>
+double Time(F&& f) {
+  double best = 0.0;
+  for (int run = 0; run < kRuns; run++) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const double ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    if (run == 0 || ms < best) {
+      best = ms;
+    }
+  }
+  return best;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937 rng(42688);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<Argb> argbs(kCount);
+  std::vector<double> hues(kCount), chromas(kCount), tones(kCount);
+  for (size_t i = 0; i < kCount; i++) {
+    argbs[i] = 0xFF000000 | (rng() & 0xFFFFFF);
+    hues[i] = unit(rng) * 360.0;
+    chromas[i] = unit(rng) * 150.0;
+    tones[i] = unit(rng) * 100.0;
+  }
+
+  std::vector<double> out_hues(kCount), out_chromas(kCount), out_tones(kCount);
+  std::vector<Argb> out_argbs(kCount);
+
+  const double scalar_from_ints = Time([&] {
+    for (size_t i = 0; i < kCount; i++) {
+      const Hct hct(argbs[i]);
+      out_hues[i] = hct.get_hue();
+      out_chromas[i] = hct.get_chroma();
+      out_tones[i] = hct.get_tone();
+    }
+  });
+  const double exact_from_ints = Time([&] {
+    HctsFromInts(argbs.data(), kCount, out_hues.data(), out_chromas.data(),
+                 out_tones.data(), HctPrecision::kExact);
+  });
+  const double fast_from_ints = Time([&] {
+    HctsFromInts(argbs.data(), kCount, out_hues.data(), out_chromas.data(),
+                 out_tones.data(), HctPrecision::kFast);
+  });
+
+  const double scalar_to_ints = Time([&] {
+    for (size_t i = 0; i < kCount; i++) {
+      out_argbs[i] = SolveToInt(hues[i], chromas[i], tones[i]);
+    }
+  });
+  const double exact_to_ints = Time([&] {
+    IntsFromHcts(hues.data(), chromas.data(), tones.data(), kCount,
+                 out_argbs.data(), HctPrecision::kExact);
+  });
+  const double fast_to_ints = Time([&] {
+    IntsFromHcts(hues.data(), chromas.data(), tones.data(), kCount,
+                 out_argbs.data(), HctPrecision::kFast);
+  });
+
+  std::printf("%zu colors, best of %d runs (ms)\n", kCount, kRuns);
+  std::printf("ARGB -> HCT  scalar %8.2f  kExact %8.2f  kFast %8.2f  (%.2fx)\n",
+              scalar_from_ints, exact_from_ints, fast_from_ints,
+              scalar_from_ints / fast_from_ints);
+  std::printf("HCT -> ARGB  scalar %8.2f  kExact %8.2f  kFast %8.2f  (%.2fx)\n",
+              scalar_to_ints, exact_to_ints, fast_to_ints,
+              scalar_to_ints / fast_to_ints);
+  return 0;
+}
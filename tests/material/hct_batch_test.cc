@@ -0,0 +1,127 @@
+/*
+ * Checks HctsFromInts() and IntsFromHcts() against the scalar Hct path.
+ *
+ * kExact must be bit-identical. kFast must stay within the tolerances stated
+ * in cam/hct_batch.h.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "CZ/AK/ThirdParty/Material/cam/hct.h"
+#include "CZ/AK/ThirdParty/Material/cam/hct_batch.h"
+#include "CZ/AK/ThirdParty/Material/cam/hct_solver.h"
+
+using namespace material_color_utilities;
+
+namespace {
+
+int failures = 0;
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    failures++;
+  }
+}
+
+double HueDistance(double a, double b) {
+  const double d = std::fabs(a - b);
+  return d > 180.0 ? 360.0 - d : d;
+}
+
+}  // namespace
+
+int main() {
+  // Every 7th opaque color, which covers all channel values.
+  std::vector<Argb> argbs;
+  for (Argb rgb = 0; rgb < 0x1000000; rgb += 7) {
+    argbs.push_back(0xFF000000 | rgb);
+  }
+
+  const size_t count = argbs.size();
+  std::vector<double> hues(count), chromas(count), tones(count);
+  std::vector<double> fast_hues(count), fast_chromas(count), fast_tones(count);
+  HctsFromInts(argbs.data(), count, hues.data(), chromas.data(), tones.data(),
+               HctPrecision::kExact);
+  HctsFromInts(argbs.data(), count, fast_hues.data(), fast_chromas.data(),
+               fast_tones.data(), HctPrecision::kFast);
+
+  size_t exact_mismatches = 0;
+  double max_hue = 0.0, max_low_chroma_hue = 0.0, max_chroma = 0.0,
+         max_tone = 0.0;
+  for (size_t i = 0; i < count; i++) {
+    const Hct hct(argbs[i]);
+    if (hct.get_hue() != hues[i] || hct.get_chroma() != chromas[i] ||
+        hct.get_tone() != tones[i]) {
+      exact_mismatches++;
+    }
+
+    const double hue = HueDistance(hues[i], fast_hues[i]);
+    if (chromas[i] >= 1.0) {
+      max_hue = std::max(max_hue, hue);
+    } else if (chromas[i] > 1e-3) {
+      max_low_chroma_hue = std::max(max_low_chroma_hue, hue);
+    }
+    max_chroma = std::max(max_chroma, std::fabs(chromas[i] - fast_chromas[i]));
+    max_tone = std::max(max_tone, std::fabs(tones[i] - fast_tones[i]));
+  }
+
+  std::printf("HctsFromInts: %zu colors, kExact mismatches %zu\n", count,
+              exact_mismatches);
+  std::printf("  kFast max error: hue %g (chroma < 1: %g), chroma %g, tone %g\n",
+              max_hue, max_low_chroma_hue, max_chroma, max_tone);
+  Check(exact_mismatches == 0, "HctsFromInts kExact matches Hct(argb)");
+  Check(max_hue <= 0.011, "HctsFromInts kFast hue within 0.011 (chroma >= 1)");
+  Check(max_low_chroma_hue <= 0.05,
+        "HctsFromInts kFast hue within 0.05 (chroma < 1)");
+  Check(max_chroma <= 0.0004, "HctsFromInts kFast chroma within 0.0004");
+  Check(max_tone <= 0.00002, "HctsFromInts kFast tone within 0.00002");
+
+  // Random HCT inputs, including out of gamut chromas.
+  const size_t hct_count = 200000;
+  std::mt19937 rng(42688);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<double> in_hues(hct_count), in_chromas(hct_count),
+      in_tones(hct_count);
+  for (size_t i = 0; i < hct_count; i++) {
+    in_hues[i] = unit(rng) * 360.0;
+    in_chromas[i] = unit(rng) * 150.0;
+    in_tones[i] = unit(rng) * 100.0;
+  }
+
+  std::vector<Argb> exact(hct_count), fast(hct_count);
+  IntsFromHcts(in_hues.data(), in_chromas.data(), in_tones.data(), hct_count,
+               exact.data(), HctPrecision::kExact);
+  IntsFromHcts(in_hues.data(), in_chromas.data(), in_tones.data(), hct_count,
+               fast.data(), HctPrecision::kFast);
+
+  size_t solve_mismatches = 0, fast_differing = 0;
+  int max_channel = 0;
+  for (size_t i = 0; i < hct_count; i++) {
+    if (SolveToInt(in_hues[i], in_chromas[i], in_tones[i]) != exact[i]) {
+      solve_mismatches++;
+    }
+    if (fast[i] != exact[i]) {
+      fast_differing++;
+    }
+    for (int shift = 0; shift < 24; shift += 8) {
+      const int a = (exact[i] >> shift) & 0xFF;
+      const int b = (fast[i] >> shift) & 0xFF;
+      max_channel = std::max(max_channel, std::abs(a - b));
+    }
+  }
+
+  std::printf("IntsFromHcts: %zu colors, kExact mismatches %zu\n", hct_count,
+              solve_mismatches);
+  std::printf("  kFast: %zu differing, max channel step %d\n", fast_differing,
+              max_channel);
+  Check(solve_mismatches == 0, "IntsFromHcts kExact matches SolveToInt()");
+  Check(max_channel <= 1, "IntsFromHcts kFast within one step per channel");
+  Check(fast_differing * 10000 <= hct_count,
+        "IntsFromHcts kFast differs for at most 1 in 10k colors");
+
+  return failures == 0 ? 0 : 1;
+}